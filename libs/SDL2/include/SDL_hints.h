@@ -1689,6 +1689,47 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_SCALE_QUALITY       "SDL_RENDER_SCALE_QUALITY"
 
+/**
+ *  \brief  A variable controlling whether textures may share the pixels of the surface they are created from
+ *
+ *  When SDL_CreateTextureFromSurface() is given a surface already in the
+ *  format the texture is stored in, renderers keeping textures in system
+ *  memory, like the software renderer, can use the surface pixels instead of
+ *  a copy. The texture keeps a reference to the surface, so it may be freed,
+ *  but its pixels must not change while the texture exists. RLE encoding
+ *  changes the pixels too, so surfaces with RLE acceleration enabled are
+ *  always copied. Updating the texture gives it its own copy first.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Textures always get their own copy of the pixels
+ *    "1"       - Textures share the surface pixels when they can
+ *
+ *  By default textures always get their own copy of the pixels.
+ *
+ *  This hint is a local extension, not available in upstream SDL.
+ */
+#define SDL_HINT_RENDER_SHARE_SURFACE_PIXELS "SDL_RENDER_SHARE_SURFACE_PIXELS"
+
+/**
+ *  \brief  A variable controlling how many threads the software renderer draws with
+ *
+ *  When this is more than 1, the software renderer splits its target into
+ *  tiles and draws the fills, points and unscaled copies of each batch on that
+ *  many threads. The output is the same as drawing on a single thread.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Draw on the rendering thread only
+ *    "-1"       - Use one thread per CPU core
+ *    "N"        - Use N threads, including the rendering thread
+ *
+ *  By default the software renderer draws on the rendering thread only.
+ *
+ *  This variable should be set when the renderer is created.
+ *
+ *  This hint is a local extension, not available in upstream SDL.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
 /**
  *  \brief  A variable controlling whether updates to the SDL screen surface should be synchronized with the vertical refresh, to avoid tearing.
  *
@@ -95,6 +95,46 @@ typedef struct SDL_Vertex
     SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
 } SDL_Vertex;
 
+/**
+ * Counters describing how the render command queue was processed, see
+ * SDL_GetRenderStats().
+ *
+ * \note This structure is a local extension, not available in upstream SDL.
+ */
+typedef struct SDL_RenderStats
+{
+    Uint32 merged_commands;     /**< Draws folded into the draw queued before them */
+    Uint32 dropped_commands;    /**< Failed draws and unused state changes removed before execution */
+    Uint32 allocations;         /**< Times the render queue called the memory allocator */
+    Uint32 arena_bytes;         /**< Memory held for commands, vertices and temporaries */
+
+    /* Commands sent to the backend, by type */
+    Uint32 state_commands;      /**< Viewport, clip rect and draw color changes */
+    Uint32 clear_commands;      /**< Clears */
+    Uint32 point_commands;      /**< Point draws */
+    Uint32 line_commands;       /**< Line draws */
+    Uint32 fill_commands;       /**< Rect fills */
+    Uint32 copy_commands;       /**< Unrotated texture copies */
+    Uint32 copy_ex_commands;    /**< Rotated or flipped texture copies */
+    Uint32 geometry_commands;   /**< Triangle draws */
+
+    Uint32 draw_calls;          /**< Commands that draw, each one a backend draw call */
+    Uint32 vertex_bytes;        /**< Vertex data sent to the backend */
+    Uint32 texture_binds;       /**< Draws using a different texture than the draw before them */
+    Uint32 target_switches;     /**< Render target changes */
+    Uint32 flushes;             /**< Times the command queue was sent to the backend */
+    Uint32 texture_flushes;     /**< Flushes forced by changing a texture the queue used */
+
+    /* Updates queued with SDL_QueueTextureUpdate() */
+    Uint32 uploads;             /**< Queued updates committed to their texture */
+    Uint32 upload_bytes;        /**< Pixel data committed by those updates */
+    Uint32 upload_stalls;       /**< Times the render thread waited for an update to be converted */
+    Uint32 upload_stall_us;     /**< Microseconds spent in those waits */
+    Uint32 uploads_pending;     /**< Queued updates left for later frames */
+
+    Uint32 converted_bytes;     /**< Texture pixel data converted to the format the texture is stored in */
+} SDL_RenderStats;
+
 /**
  * The scaling mode for a texture.
  */
@@ -308,6 +348,30 @@ extern DECLSPEC int SDLCALL SDL_GetRendererInfo(SDL_Renderer * renderer,
 extern DECLSPEC int SDLCALL SDL_GetRendererOutputSize(SDL_Renderer * renderer,
                                                       int *w, int *h);
 
+/**
+ * Get the pixel format that textures of a rendering context can be filled in
+ * without conversion.
+ *
+ * Pixels in this format go to a texture as they are, with SDL_UpdateTexture()
+ * on a texture created in it or with SDL_CreateTextureFromSurface(), so
+ * surfaces meant to become textures are best created in it. It is also the
+ * format SDL_CreateTextureFromSurface() picks for surfaces the renderer can't
+ * store as they are. SDL_RenderStats counts the bytes converted otherwise.
+ *
+ * \param renderer the rendering context
+ * \param alpha SDL_TRUE for a format with an alpha channel, SDL_FALSE for
+ *              one without; if the renderer has none, its preferred format
+ *              is returned
+ * \returns a pixel format, or SDL_PIXELFORMAT_UNKNOWN on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_CreateTextureFromSurface
+ * \sa SDL_GetRendererInfo
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetRendererUploadFormat(SDL_Renderer *renderer, SDL_bool alpha);
+
 /**
  * Create a texture for a rendering context.
  *
@@ -345,7 +409,9 @@ extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateTexture(SDL_Renderer * renderer,
  *
  * The pixel format of the created texture may be different from the pixel
  * format of the surface. Use SDL_QueryTexture() to query the pixel format of
- * the texture.
+ * the texture. Surfaces in the format SDL_GetRendererUploadFormat() returns
+ * are copied without conversion, or with SDL_HINT_RENDER_SHARE_SURFACE_PIXELS
+ * set, may not be copied at all.
  *
  * \param renderer the rendering context
  * \param surface the SDL_Surface structure containing pixel data used to fill
@@ -357,10 +423,36 @@ extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateTexture(SDL_Renderer * renderer,
  *
  * \sa SDL_CreateTexture
  * \sa SDL_DestroyTexture
+ * \sa SDL_GetRendererUploadFormat
  * \sa SDL_QueryTexture
  */
 extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface);
 
+/**
+ * Create a texture from an existing surface, converting its pixels on a
+ * worker thread.
+ *
+ * This works like SDL_CreateTextureFromSurface(), but the texture contents
+ * are filled in with SDL_QueueTextureUpdate(), so the pixel format conversion
+ * doesn't hold up the calling thread. The texture can be used right away;
+ * drawing it waits for its contents if they aren't ready yet.
+ *
+ * Surfaces with a palette, a color key or RLE acceleration are still
+ * converted on the calling thread, only their upload is queued.
+ *
+ * \param renderer the rendering context
+ * \param surface the SDL_Surface structure containing pixel data used to fill
+ *                the texture
+ * \returns the created texture or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_CreateTextureFromSurface
+ * \sa SDL_QueueTextureUpdate
+ */
+extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurfaceAsync(SDL_Renderer *renderer, SDL_Surface *surface);
+
 /**
  * Query the attributes of a texture.
  *
@@ -565,6 +657,47 @@ extern DECLSPEC int SDLCALL SDL_SetTextureUserData(SDL_Texture * texture,
  */
 extern DECLSPEC void * SDLCALL SDL_GetTextureUserData(SDL_Texture * texture);
 
+/**
+ * Turn tracking of the area drawn to in a render target on or off.
+ *
+ * While tracking is on, every clear, draw and update that may change the
+ * texture adds the bounding rectangle of what it changes to the texture's
+ * damage, which SDL_GetTextureDamage() returns. An app that renders into a
+ * target and then copies it elsewhere can use it to copy only what changed.
+ *
+ * Turning tracking on or off empties the damage.
+ *
+ * \param texture the texture to track, created with
+ *                SDL_TEXTUREACCESS_TARGET.
+ * \param enabled SDL_TRUE to track the damage, SDL_FALSE to stop.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_GetTextureDamage
+ */
+extern DECLSPEC int SDLCALL SDL_SetTextureDamageTracking(SDL_Texture *texture, SDL_bool enabled);
+
+/**
+ * Get the area of a render target changed since the last call, and start
+ * over.
+ *
+ * The area is the union of the bounds of the changes, clipped to the
+ * viewport and clip rectangle they were drawn with. It includes draws still
+ * waiting in the command queue. The rectangle is empty if nothing changed.
+ *
+ * \param texture the texture to query, with damage tracking turned on.
+ * \param rect a pointer filled in with the changed area.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_SetTextureDamageTracking
+ */
+extern DECLSPEC int SDLCALL SDL_GetTextureDamage(SDL_Texture *texture, SDL_Rect *rect);
+
 /**
  * Update the given texture rectangle with new pixel data.
  *
@@ -598,6 +731,77 @@ extern DECLSPEC int SDLCALL SDL_UpdateTexture(SDL_Texture * texture,
                                               const SDL_Rect * rect,
                                               const void *pixels, int pitch);
 
+/**
+ * Queue an update of a rectangle within a texture from a surface.
+ *
+ * The surface pixels are converted to the format the renderer stores the
+ * texture in by a worker thread, and the result is committed to the texture
+ * by the thread using the renderer: at the next SDL_RenderPresent(), within
+ * the budget set with SDL_SetTextureUploadBudget(), or before the texture is
+ * drawn, updated, locked or made the render target, whichever comes first.
+ * Updates of the same texture are committed in the order they were queued.
+ *
+ * The surface is kept until its pixels are converted, so it may be freed
+ * right after this call, but its pixels must not change until then. The
+ * pixels are converted like SDL_ConvertPixels() does, so the color key,
+ * alpha and color modulation of the surface are not applied. Surfaces with
+ * a palette or RLE acceleration are converted on the calling thread first.
+ *
+ * An update of the current render target is converted on the calling thread
+ * and done immediately.
+ *
+ * \param texture the texture to update
+ * \param rect an SDL_Rect structure representing the area to update, or NULL
+ *             to update the entire texture
+ * \param surface the surface whose top left pixels fill the area; it must be
+ *                at least as large as the area
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_FlushTextureUpdates
+ * \sa SDL_SetTextureUploadBudget
+ * \sa SDL_UpdateTexture
+ */
+extern DECLSPEC int SDLCALL SDL_QueueTextureUpdate(SDL_Texture *texture,
+                                                   const SDL_Rect *rect,
+                                                   SDL_Surface *surface);
+
+/**
+ * Limit how much queued texture update data is committed per frame.
+ *
+ * SDL_RenderPresent() commits converted updates in the order they were
+ * queued until the budget is used up, leaving the rest for later frames. At
+ * least one update is committed each frame, however large. Updates of a
+ * texture that is used before its turn are committed when it is used,
+ * regardless of the budget.
+ *
+ * \param renderer the rendering context
+ * \param bytes the most pixel data to commit per frame, or 0 for no limit,
+ *              which is the default
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_QueueTextureUpdate
+ */
+extern DECLSPEC int SDLCALL SDL_SetTextureUploadBudget(SDL_Renderer *renderer, int bytes);
+
+/**
+ * Wait for all queued texture updates and commit them.
+ *
+ * \param renderer the rendering context
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_QueueTextureUpdate
+ */
+extern DECLSPEC int SDLCALL SDL_FlushTextureUpdates(SDL_Renderer *renderer);
+
 /**
  * Update a rectangle within a planar YV12 or IYUV texture with new pixel
  * data.
@@ -1592,6 +1796,39 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyF(SDL_Renderer * renderer,
                                             const SDL_Rect * srcrect,
                                             const SDL_FRect * dstrect);
 
+/**
+ * Copy many portions of a texture to the current rendering target at subpixel
+ * precision, each with its own color and alpha modulation.
+ *
+ * This draws the same as calling SDL_RenderCopyF() once per rectangle, but
+ * queues all of them as one draw, which is much cheaper for large numbers of
+ * small copies such as the cells of a tile grid.
+ *
+ * The software and PSP renderers don't draw geometry, so they still queue
+ * one copy per rectangle. This saves the calls into SDL but not the draws.
+ *
+ * \param renderer the renderer which should copy parts of a texture
+ * \param texture the source texture
+ * \param srcrects an array of source rectangles, or NULL to copy the entire
+ *                 texture each time
+ * \param dstrects an array of destination rectangles
+ * \param colors an array of colors to modulate each copy with, in place of
+ *               the texture's color and alpha mod, or NULL to use those
+ * \param count the number of copies
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_RenderCopyF
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyBatch(SDL_Renderer *renderer,
+                                                SDL_Texture *texture,
+                                                const SDL_Rect *srcrects,
+                                                const SDL_FRect *dstrects,
+                                                const SDL_Color *colors,
+                                                int count);
+
 /**
  * Copy a portion of the source texture to the current rendering target, with
  * rotation and flipping, at subpixel precision.
@@ -1913,6 +2150,24 @@ extern DECLSPEC void *SDLCALL SDL_RenderGetMetalCommandEncoder(SDL_Renderer * re
  */
 extern DECLSPEC int SDLCALL SDL_RenderSetVSync(SDL_Renderer* renderer, int vsync);
 
+/**
+ * Get queue statistics for the most recently presented frame.
+ *
+ * The counters cover every command queue flush since the previous call to
+ * SDL_RenderPresent(), up to and including the flush done by the latest
+ * SDL_RenderPresent(). They are all zero until the first frame is presented.
+ *
+ * \param renderer the rendering context
+ * \param stats an SDL_RenderStats structure filled in with the counters
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \note This function is a local extension, not available in upstream SDL.
+ *
+ * \sa SDL_RenderPresent
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderStats(SDL_Renderer *renderer, SDL_RenderStats *stats);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
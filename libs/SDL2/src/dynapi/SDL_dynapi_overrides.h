@@ -898,3 +898,12 @@
 #define SDL_DestroyWindowSurface SDL_DestroyWindowSurface_REAL
 #define SDL_GDKGetDefaultUser SDL_GDKGetDefaultUser_REAL
 #define SDL_GameControllerGetSteamHandle SDL_GameControllerGetSteamHandle_REAL
+#define SDL_GetRenderStats SDL_GetRenderStats_REAL
+#define SDL_RenderCopyBatch SDL_RenderCopyBatch_REAL
+#define SDL_SetTextureDamageTracking SDL_SetTextureDamageTracking_REAL
+#define SDL_GetTextureDamage SDL_GetTextureDamage_REAL
+#define SDL_CreateTextureFromSurfaceAsync SDL_CreateTextureFromSurfaceAsync_REAL
+#define SDL_QueueTextureUpdate SDL_QueueTextureUpdate_REAL
+#define SDL_SetTextureUploadBudget SDL_SetTextureUploadBudget_REAL
+#define SDL_FlushTextureUpdates SDL_FlushTextureUpdates_REAL
+#define SDL_GetRendererUploadFormat SDL_GetRendererUploadFormat_REAL
@@ -985,3 +985,12 @@ SDL_DYNAPI_PROC(int,SDL_DestroyWindowSurface,(SDL_Window *a),(a),return)
 SDL_DYNAPI_PROC(int,SDL_GDKGetDefaultUser,(XUserHandle *a),(a),return)
 #endif
 SDL_DYNAPI_PROC(Uint64,SDL_GameControllerGetSteamHandle,(SDL_GameController *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyBatch,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_FRect *d, const SDL_Color *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_SetTextureDamageTracking,(SDL_Texture *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetTextureDamage,(SDL_Texture *a, SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_CreateTextureFromSurfaceAsync,(SDL_Renderer *a, SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_QueueTextureUpdate,(SDL_Texture *a, const SDL_Rect *b, SDL_Surface *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_SetTextureUploadBudget,(SDL_Renderer *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_FlushTextureUpdates,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(Uint32,SDL_GetRendererUploadFormat,(SDL_Renderer *a, SDL_bool b),(a,b),return)
@@ -22,11 +22,13 @@
 
 /* The SDL 2D rendering system */
 
+#include "SDL_cpuinfo.h"
 #include "SDL_hints.h"
 #include "SDL_render.h"
 #include "SDL_timer.h"
 #include "SDL_sysrender.h"
 #include "software/SDL_render_sw_c.h"
+#include "../thread/SDL_systhread.h"
 #include "../video/SDL_pixels_c.h"
 
 #if defined(__ANDROID__)
@@ -233,6 +235,227 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+static SDL_bool SameViewport(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    return SDL_memcmp(&a->data.viewport.rect, &b->data.viewport.rect, sizeof(SDL_Rect)) == 0;
+}
+
+static SDL_bool SameClipRect(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    if (a->data.cliprect.enabled != b->data.cliprect.enabled) {
+        return SDL_FALSE;
+    }
+    return !a->data.cliprect.enabled || SDL_memcmp(&a->data.cliprect.rect, &b->data.cliprect.rect, sizeof(SDL_Rect)) == 0;
+}
+
+static SDL_bool SameDrawColor(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    return a->data.color.r == b->data.color.r && a->data.color.g == b->data.color.g &&
+           a->data.color.b == b->data.color.b && a->data.color.a == b->data.color.a;
+}
+
+/* Tracks one kind of state command while scanning the queue: the command in
+ * effect for the draws seen so far, and a newer one no draw has used yet. */
+typedef struct
+{
+    SDL_RenderCommand *pending;
+    SDL_RenderCommand *current;
+    SDL_bool (*same)(const SDL_RenderCommand *a, const SDL_RenderCommand *b);
+} PendingRenderState;
+
+static void SetPendingRenderState(PendingRenderState *state, SDL_RenderCommand *cmd)
+{
+    if (state->pending) {
+        state->pending->command = SDL_RENDERCMD_NO_OP; /* replaced before any draw used it. */
+    }
+    state->pending = cmd;
+}
+
+static void UsePendingRenderState(PendingRenderState *state)
+{
+    if (state->pending) {
+        if (state->current && state->same(state->current, state->pending)) {
+            state->pending->command = SDL_RENDERCMD_NO_OP; /* already in effect. */
+        } else {
+            state->current = state->pending;
+        }
+        state->pending = NULL;
+    }
+}
+
+/* Remove commands that can't change the output before the backend sees the
+ * queue: draws that failed to queue, and viewport, clip rect and draw color
+ * changes that nothing uses or that repeat the state already in effect. */
+static void OptimizeRenderCommands(SDL_Renderer *renderer)
+{
+    PendingRenderState viewport = { NULL, NULL, SameViewport };
+    PendingRenderState cliprect = { NULL, NULL, SameClipRect };
+    PendingRenderState color = { NULL, NULL, SameDrawColor };
+    SDL_RenderCommand *cmd;
+    SDL_RenderCommand *prev = NULL;
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_NO_OP:
+            break;
+
+        case SDL_RENDERCMD_SETVIEWPORT:
+            SetPendingRenderState(&viewport, cmd);
+            break;
+
+        case SDL_RENDERCMD_SETCLIPRECT:
+            SetPendingRenderState(&cliprect, cmd);
+            break;
+
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+            SetPendingRenderState(&color, cmd);
+            break;
+
+        case SDL_RENDERCMD_GEOMETRY:
+            /* geometry carries its own colors. */
+            UsePendingRenderState(&viewport);
+            UsePendingRenderState(&cliprect);
+            break;
+
+        default:
+            UsePendingRenderState(&viewport);
+            UsePendingRenderState(&cliprect);
+            UsePendingRenderState(&color);
+            break;
+        }
+    }
+
+    /* State left over at the end of the queue is unused; the next flush queues it again. */
+    SetPendingRenderState(&viewport, NULL);
+    SetPendingRenderState(&cliprect, NULL);
+    SetPendingRenderState(&color, NULL);
+
+    cmd = renderer->render_commands;
+    while (cmd) {
+        SDL_RenderCommand *next = cmd->next;
+        if (cmd->command == SDL_RENDERCMD_NO_OP) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                renderer->render_commands = next;
+            }
+            cmd->next = renderer->render_commands_pool;
+            renderer->render_commands_pool = cmd;
+            renderer->stats.dropped_commands++;
+        } else {
+            prev = cmd;
+        }
+        cmd = next;
+    }
+    renderer->render_commands_tail = prev;
+}
+
+/* Temporary memory for queueing a call, released with FreeRenderScratch().
+   It comes from the renderer's scratch buffer when that has room, which it
+   does once the queue has been flushed after a call needing as much. */
+static void *AllocateRenderScratch(SDL_Renderer *renderer, const size_t numbytes)
+{
+    const size_t aligned = (numbytes + 15) & ~((size_t)15);
+    void *retval;
+
+    if (renderer->scratch_used + aligned <= renderer->scratch_allocation) {
+        retval = ((Uint8 *)renderer->scratch) + renderer->scratch_used;
+    } else {
+        retval = SDL_malloc(numbytes);
+        renderer->stats.allocations++;
+        if (!retval) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+    }
+
+    renderer->scratch_used += aligned;
+    if (renderer->scratch_high_water < renderer->scratch_used) {
+        renderer->scratch_high_water = renderer->scratch_used;
+    }
+    return retval;
+}
+
+static void FreeRenderScratch(SDL_Renderer *renderer, void *ptr, const size_t numbytes)
+{
+    const Uint8 *scratch = (const Uint8 *)renderer->scratch;
+
+    if (!ptr) {
+        return;
+    }
+    renderer->scratch_used -= (numbytes + 15) & ~((size_t)15);
+    if ((const Uint8 *)ptr < scratch || (const Uint8 *)ptr >= scratch + renderer->scratch_allocation) {
+        SDL_free(ptr);
+    }
+}
+
+/* Grows the scratch buffer to the most used so far, when none of it is in use */
+static void ReserveRenderScratch(SDL_Renderer *renderer)
+{
+    if (renderer->scratch_used == 0 && renderer->scratch_allocation < renderer->scratch_high_water) {
+        void *ptr = SDL_malloc(renderer->scratch_high_water);
+        renderer->stats.allocations++;
+        if (ptr) {
+            SDL_free(renderer->scratch);
+            renderer->scratch = ptr;
+            renderer->scratch_allocation = renderer->scratch_high_water;
+        }
+    }
+}
+
+/* Counts what the backend is about to be sent */
+static void CountRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderStats *stats = &renderer->stats;
+    const SDL_RenderCommand *cmd;
+    SDL_Texture *texture = NULL;
+
+    stats->flushes++;
+    stats->vertex_bytes += (Uint32)renderer->vertex_data_used;
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+            stats->state_commands++;
+            break;
+        case SDL_RENDERCMD_CLEAR:
+            stats->clear_commands++;
+            stats->draw_calls++;
+            break;
+        case SDL_RENDERCMD_DRAW_POINTS:
+            stats->point_commands++;
+            break;
+        case SDL_RENDERCMD_DRAW_LINES:
+            stats->line_commands++;
+            break;
+        case SDL_RENDERCMD_FILL_RECTS:
+            stats->fill_commands++;
+            break;
+        case SDL_RENDERCMD_COPY:
+            stats->copy_commands++;
+            break;
+        case SDL_RENDERCMD_COPY_EX:
+            stats->copy_ex_commands++;
+            break;
+        case SDL_RENDERCMD_GEOMETRY:
+            stats->geometry_commands++;
+            break;
+        case SDL_RENDERCMD_NO_OP:
+            break;
+        }
+
+        if (cmd->command >= SDL_RENDERCMD_DRAW_POINTS) {
+            stats->draw_calls++;
+            if (cmd->data.draw.texture && cmd->data.draw.texture != texture) {
+                texture = cmd->data.draw.texture;
+                stats->texture_binds++;
+            }
+        }
+    }
+}
+
 static int FlushRenderCommands(SDL_Renderer *renderer)
 {
     int retval;
@@ -244,9 +467,17 @@ static int FlushRenderCommands(SDL_Renderer *renderer)
         return 0;
     }
 
+    OptimizeRenderCommands(renderer);
+
     DebugLogRenderCommands(renderer->render_commands);
 
-    retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    CountRenderCommands(renderer);
+
+    if (renderer->render_commands) {
+        retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    } else {
+        retval = 0;
+    }
 
     /* Move the whole render command queue to the unused pool so we can reuse them next time. */
     if (renderer->render_commands_tail) {
@@ -256,6 +487,7 @@ static int FlushRenderCommands(SDL_Renderer *renderer)
         renderer->render_commands = NULL;
     }
     renderer->vertex_data_used = 0;
+    ReserveRenderScratch(renderer);
     renderer->render_command_generation++;
     renderer->color_queued = SDL_FALSE;
     renderer->viewport_queued = SDL_FALSE;
@@ -268,6 +500,7 @@ static int FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
     SDL_Renderer *renderer = texture->renderer;
     if (texture->last_command_generation == renderer->render_command_generation) {
         /* the current command queue depends on this texture, flush the queue now before it changes */
+        renderer->stats.texture_flushes++;
         return FlushRenderCommands(renderer);
     }
     return 0;
@@ -300,6 +533,7 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes,
         }
 
         ptr = SDL_realloc(renderer->vertex_data, newsize);
+        renderer->stats.allocations++;
 
         if (!ptr) {
             SDL_OutOfMemory();
@@ -318,22 +552,50 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes,
     return ((Uint8 *)renderer->vertex_data) + aligned;
 }
 
+/* Commands are allocated in blocks and never freed until the renderer is destroyed */
+typedef struct SDL_RenderCommandBlock
+{
+    struct SDL_RenderCommandBlock *next;
+    SDL_RenderCommand commands[1]; /* actually as many as fit the allocation */
+} SDL_RenderCommandBlock;
+
+static SDL_bool AllocateRenderCommandBlock(SDL_Renderer *renderer)
+{
+    /* Double the pool each time it runs dry, so it soon covers the largest frame */
+    const size_t count = SDL_max(renderer->render_commands_allocated, 64);
+    SDL_RenderCommandBlock *block;
+    SDL_RenderCommand *cmds;
+    size_t i;
+
+    block = (SDL_RenderCommandBlock *)SDL_calloc(1, sizeof(*block) + (count - 1) * sizeof(SDL_RenderCommand));
+    renderer->stats.allocations++;
+    if (!block) {
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+    block->next = renderer->render_command_blocks;
+    renderer->render_command_blocks = block;
+    renderer->render_commands_allocated += count;
+
+    cmds = block->commands;
+    for (i = 0; i < count; i++) {
+        cmds[i].next = (i + 1 < count) ? &cmds[i + 1] : renderer->render_commands_pool;
+    }
+    renderer->render_commands_pool = cmds;
+    return SDL_TRUE;
+}
+
 static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
 {
     SDL_RenderCommand *retval = NULL;
 
     /* !!! FIXME: are there threading limitations in SDL's render API? If not, we need to mutex this. */
-    retval = renderer->render_commands_pool;
-    if (retval) {
-        renderer->render_commands_pool = retval->next;
-        retval->next = NULL;
-    } else {
-        retval = SDL_calloc(1, sizeof(*retval));
-        if (!retval) {
-            SDL_OutOfMemory();
-            return NULL;
-        }
+    if (!renderer->render_commands_pool && !AllocateRenderCommandBlock(renderer)) {
+        return NULL;
     }
+    retval = renderer->render_commands_pool;
+    renderer->render_commands_pool = retval->next;
+    retval->next = NULL;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
     if (renderer->render_commands_tail) {
@@ -425,6 +687,141 @@ static int QueueCmdSetDrawColor(SDL_Renderer *renderer, SDL_Color *col)
     return retval;
 }
 
+/* The damage that draws to the current target add to, NULL if it isn't tracked */
+static SDL_Rect *GetRenderDamage(SDL_Renderer *renderer)
+{
+    if (renderer->target) {
+        return renderer->target->track_damage ? &renderer->target->damage : NULL;
+    }
+    return renderer->track_damage ? &renderer->damage : NULL;
+}
+
+static void AddDamage(SDL_Rect *damage, const SDL_Rect *rect)
+{
+    if (SDL_RectEmpty(rect)) {
+        return;
+    }
+    if (SDL_RectEmpty(damage)) {
+        *damage = *rect;
+    } else {
+        SDL_UnionRect(damage, rect, damage);
+    }
+}
+
+/* Adds a draw's bounds, in viewport coordinates, clipped like the draw is */
+static void AddRenderDamageBounds(SDL_Renderer *renderer, SDL_Rect *damage, float minx, float miny, float maxx, float maxy)
+{
+    SDL_Rect viewport, rect;
+
+    viewport.x = (int)SDL_floor(renderer->viewport.x);
+    viewport.y = (int)SDL_floor(renderer->viewport.y);
+    viewport.w = (int)SDL_floor(renderer->viewport.w);
+    viewport.h = (int)SDL_floor(renderer->viewport.h);
+
+    /* Clamp before converting, so huge coordinates don't overflow */
+    minx = SDL_clamp(minx, -1.0f, (float)viewport.w + 1.0f);
+    miny = SDL_clamp(miny, -1.0f, (float)viewport.h + 1.0f);
+    maxx = SDL_clamp(maxx, -1.0f, (float)viewport.w + 1.0f);
+    maxy = SDL_clamp(maxy, -1.0f, (float)viewport.h + 1.0f);
+    rect.x = viewport.x + (int)SDL_floorf(minx);
+    rect.y = viewport.y + (int)SDL_floorf(miny);
+    rect.w = viewport.x + (int)SDL_ceilf(maxx) - rect.x;
+    rect.h = viewport.y + (int)SDL_ceilf(maxy) - rect.y;
+    if (!SDL_IntersectRect(&rect, &viewport, &rect)) {
+        return;
+    }
+    if (renderer->clipping_enabled) {
+        SDL_Rect clip;
+        clip.x = viewport.x + (int)SDL_floor(renderer->clip_rect.x);
+        clip.y = viewport.y + (int)SDL_floor(renderer->clip_rect.y);
+        clip.w = (int)SDL_floor(renderer->clip_rect.w);
+        clip.h = (int)SDL_floor(renderer->clip_rect.h);
+        if (!SDL_IntersectRect(&rect, &clip, &rect)) {
+            return;
+        }
+    }
+    AddDamage(damage, &rect);
+}
+
+/* Points and lines also cover the pixel right and below their last coordinate */
+static void AddRenderDamagePoints(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
+{
+    SDL_Rect *damage = GetRenderDamage(renderer);
+    float minx, miny, maxx, maxy;
+    int i;
+
+    if (!damage || count <= 0) {
+        return;
+    }
+    minx = maxx = points[0].x;
+    miny = maxy = points[0].y;
+    for (i = 1; i < count; i++) {
+        minx = SDL_min(minx, points[i].x);
+        miny = SDL_min(miny, points[i].y);
+        maxx = SDL_max(maxx, points[i].x);
+        maxy = SDL_max(maxy, points[i].y);
+    }
+    AddRenderDamageBounds(renderer, damage, minx, miny, maxx + 1.0f, maxy + 1.0f);
+}
+
+static void AddRenderDamageRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
+{
+    SDL_Rect *damage = GetRenderDamage(renderer);
+    float minx, miny, maxx, maxy;
+    int i;
+
+    if (!damage || count <= 0) {
+        return;
+    }
+    minx = miny = SDL_MAX_SINT32;
+    maxx = maxy = SDL_MIN_SINT32;
+    for (i = 0; i < count; i++) {
+        minx = SDL_min(minx, rects[i].x);
+        miny = SDL_min(miny, rects[i].y);
+        maxx = SDL_max(maxx, rects[i].x + rects[i].w);
+        maxy = SDL_max(maxy, rects[i].y + rects[i].h);
+    }
+    AddRenderDamageBounds(renderer, damage, minx, miny, maxx, maxy);
+}
+
+static void AddRenderDamageVertices(SDL_Renderer *renderer, const float *xy, int xy_stride, int num_vertices, float scale_x, float scale_y)
+{
+    SDL_Rect *damage = GetRenderDamage(renderer);
+    float minx, miny, maxx, maxy;
+    int i;
+
+    if (!damage || num_vertices <= 0) {
+        return;
+    }
+    minx = maxx = xy[0];
+    miny = maxy = xy[1];
+    for (i = 1; i < num_vertices; i++) {
+        const float *v = (const float *)((const char *)xy + i * xy_stride);
+        minx = SDL_min(minx, v[0]);
+        miny = SDL_min(miny, v[1]);
+        maxx = SDL_max(maxx, v[0]);
+        maxy = SDL_max(maxy, v[1]);
+    }
+    AddRenderDamageBounds(renderer, damage, minx * scale_x, miny * scale_y, maxx * scale_x, maxy * scale_y);
+}
+
+/* A rotated copy stays within the circle around its center through its farthest corner */
+static void AddRenderDamageCopyEx(SDL_Renderer *renderer, const SDL_FRect *dstrect, const SDL_FPoint *center, float scale_x, float scale_y)
+{
+    SDL_Rect *damage = GetRenderDamage(renderer);
+    float cx, cy, dx, dy, radius;
+
+    if (!damage) {
+        return;
+    }
+    cx = dstrect->x + center->x;
+    cy = dstrect->y + center->y;
+    dx = SDL_max(center->x, dstrect->w - center->x);
+    dy = SDL_max(center->y, dstrect->h - center->y);
+    radius = SDL_sqrtf(dx * dx + dy * dy) + 1.0f;
+    AddRenderDamageBounds(renderer, damage, (cx - radius) * scale_x, (cy - radius) * scale_y, (cx + radius) * scale_x, (cy + radius) * scale_y);
+}
+
 static int QueueCmdClear(SDL_Renderer *renderer)
 {
     SDL_RenderCommand *cmd = AllocateRenderCommand(renderer);
@@ -438,6 +835,16 @@ static int QueueCmdClear(SDL_Renderer *renderer)
     cmd->data.color.g = renderer->color.g;
     cmd->data.color.b = renderer->color.b;
     cmd->data.color.a = renderer->color.a;
+
+    if (GetRenderDamage(renderer)) {
+        /* By definition the clear ignores the viewport and clip rect */
+        SDL_Rect rect;
+        rect.x = 0;
+        rect.y = 0;
+        if (SDL_GetRendererOutputSize(renderer, &rect.w, &rect.h) == 0) {
+            AddDamage(GetRenderDamage(renderer), &rect);
+        }
+    }
     return 0;
 }
 
@@ -456,7 +863,7 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
         blendMode = renderer->blendMode;
     }
 
-    if (cmdtype != SDL_RENDERCMD_GEOMETRY) {
+    if (cmdtype != SDL_RENDERCMD_GEOMETRY && !renderer->draw_color_in_commands) {
         /* !!! FIXME: drop this draw if viewport w or h is zero. */
         retval = QueueCmdSetDrawColor(renderer, color);
     }
@@ -487,6 +894,48 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
     return cmd;
 }
 
+/* Fold a draw that was just queued into the command queued right before it.
+ * This works when nothing was queued in between, both draw the same way, and
+ * the backend put the new vertex data directly behind the previous command's:
+ * the backend then processes both as one command with the combined count. */
+static void MergeRenderCommand(SDL_Renderer *renderer, SDL_RenderCommand *prev, SDL_RenderCommand *cmd, const size_t vertex_start)
+{
+    if (!prev || prev->next != cmd || prev->command != cmd->command) {
+        return;
+    }
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_FILL_RECTS:
+    case SDL_RENDERCMD_COPY:
+    case SDL_RENDERCMD_GEOMETRY:
+        break;
+    default:
+        return; /* line strips and rotated copies can't be concatenated. */
+    }
+
+    if (cmd->data.draw.first != vertex_start ||
+        cmd->data.draw.texture != prev->data.draw.texture ||
+        cmd->data.draw.blend != prev->data.draw.blend) {
+        return;
+    }
+
+    if (!renderer->draw_color_in_vertices || cmd->command != SDL_RENDERCMD_GEOMETRY) {
+        if (cmd->data.draw.r != prev->data.draw.r ||
+            cmd->data.draw.g != prev->data.draw.g ||
+            cmd->data.draw.b != prev->data.draw.b ||
+            cmd->data.draw.a != prev->data.draw.a) {
+            return;
+        }
+    }
+
+    prev->data.draw.count += cmd->data.draw.count;
+    prev->next = NULL;
+    renderer->render_commands_tail = prev;
+    cmd->next = renderer->render_commands_pool;
+    renderer->render_commands_pool = cmd;
+    renderer->stats.merged_commands++;
+}
+
 static int QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, const int count)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_POINTS, NULL);
@@ -495,6 +944,8 @@ static int QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points,
         retval = renderer->QueueDrawPoints(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            AddRenderDamagePoints(renderer, points, count);
         }
     }
     return retval;
@@ -508,6 +959,8 @@ static int QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, c
         retval = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            AddRenderDamagePoints(renderer, points, count);
         }
     }
     return retval;
@@ -515,6 +968,7 @@ static int QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, c
 
 static int QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, const int count)
 {
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
     SDL_RenderCommand *cmd;
     int retval = -1;
     const int use_rendergeometry = (!renderer->QueueFillRects);
@@ -522,11 +976,13 @@ static int QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, con
     cmd = PrepQueueCmdDraw(renderer, (use_rendergeometry ? SDL_RENDERCMD_GEOMETRY : SDL_RENDERCMD_FILL_RECTS), NULL);
 
     if (cmd) {
+        const size_t vertex_start = renderer->vertex_data_used;
+
         if (use_rendergeometry) {
-            SDL_bool isstack1;
-            SDL_bool isstack2;
-            float *xy = SDL_small_alloc(float, 4 * 2 * count, &isstack1);
-            int *indices = SDL_small_alloc(int, 6 * count, &isstack2);
+            const size_t xy_size = 4 * 2 * count * sizeof(float);
+            const size_t indices_size = 6 * count * sizeof(int);
+            float *xy = (float *)AllocateRenderScratch(renderer, xy_size);
+            int *indices = (int *)AllocateRenderScratch(renderer, indices_size);
 
             if (xy && indices) {
                 int i;
@@ -572,15 +1028,21 @@ static int QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, con
 
                 if (retval < 0) {
                     cmd->command = SDL_RENDERCMD_NO_OP;
+                } else {
+                    MergeRenderCommand(renderer, prev, cmd, vertex_start);
+                    AddRenderDamageRects(renderer, rects, count);
                 }
             }
-            SDL_small_free(xy, isstack1);
-            SDL_small_free(indices, isstack2);
+            FreeRenderScratch(renderer, xy, xy_size);
+            FreeRenderScratch(renderer, indices, indices_size);
 
         } else {
             retval = renderer->QueueFillRects(renderer, cmd, rects, count);
             if (retval < 0) {
                 cmd->command = SDL_RENDERCMD_NO_OP;
+            } else {
+                MergeRenderCommand(renderer, prev, cmd, vertex_start);
+                AddRenderDamageRects(renderer, rects, count);
             }
         }
     }
@@ -589,12 +1051,17 @@ static int QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, con
 
 static int QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect, const SDL_FRect *dstrect)
 {
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_COPY, texture);
     int retval = -1;
     if (cmd) {
+        const size_t vertex_start = renderer->vertex_data_used;
         retval = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            MergeRenderCommand(renderer, prev, cmd, vertex_start);
+            AddRenderDamageRects(renderer, dstrect, 1);
         }
     }
     return retval;
@@ -610,6 +1077,8 @@ static int QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
         retval = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip, scale_x, scale_y);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            AddRenderDamageCopyEx(renderer, dstrect, center, scale_x, scale_y);
         }
     }
     return retval;
@@ -623,10 +1092,12 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                             const void *indices, int num_indices, int size_indices,
                             float scale_x, float scale_y)
 {
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
     SDL_RenderCommand *cmd;
     int retval = -1;
     cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_GEOMETRY, texture);
     if (cmd) {
+        const size_t vertex_start = renderer->vertex_data_used;
         retval = renderer->QueueGeometry(renderer, cmd, texture,
                                          xy, xy_stride,
                                          color, color_stride, uv, uv_stride,
@@ -634,6 +1105,9 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                                          scale_x, scale_y);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            MergeRenderCommand(renderer, prev, cmd, vertex_start);
+            AddRenderDamageVertices(renderer, xy, xy_stride, num_vertices, scale_x, scale_y);
         }
     }
     return retval;
@@ -1213,6 +1687,21 @@ static SDL_bool IsSupportedFormat(SDL_Renderer *renderer, Uint32 format)
     return SDL_FALSE;
 }
 
+/* The first format the renderer supports with or without alpha, which
+   textures are stored in as is */
+static Uint32 GetUploadFormat(SDL_Renderer *renderer, SDL_bool alpha)
+{
+    Uint32 i;
+
+    for (i = 0; i < renderer->info.num_texture_formats; ++i) {
+        if (!SDL_ISPIXELFORMAT_FOURCC(renderer->info.texture_formats[i]) &&
+            SDL_ISPIXELFORMAT_ALPHA(renderer->info.texture_formats[i]) == alpha) {
+            return renderer->info.texture_formats[i];
+        }
+    }
+    return renderer->info.texture_formats[0];
+}
+
 static Uint32 GetClosestSupportedFormat(SDL_Renderer *renderer, Uint32 format)
 {
     Uint32 i;
@@ -1224,18 +1713,24 @@ static Uint32 GetClosestSupportedFormat(SDL_Renderer *renderer, Uint32 format)
                 return renderer->info.texture_formats[i];
             }
         }
-    } else {
-        SDL_bool hasAlpha = SDL_ISPIXELFORMAT_ALPHA(format);
-
-        /* We just want to match the first format that has the same channels */
-        for (i = 0; i < renderer->info.num_texture_formats; ++i) {
-            if (!SDL_ISPIXELFORMAT_FOURCC(renderer->info.texture_formats[i]) &&
-                SDL_ISPIXELFORMAT_ALPHA(renderer->info.texture_formats[i]) == hasAlpha) {
-                return renderer->info.texture_formats[i];
-            }
-        }
+        return renderer->info.texture_formats[0];
     }
-    return renderer->info.texture_formats[0];
+
+    /* We just want to match the first format that has the same channels */
+    return GetUploadFormat(renderer, SDL_ISPIXELFORMAT_ALPHA(format) ? SDL_TRUE : SDL_FALSE);
+}
+
+Uint32 SDL_GetRendererUploadFormat(SDL_Renderer *renderer, SDL_bool alpha)
+{
+    CHECK_RENDERER_MAGIC(renderer, SDL_PIXELFORMAT_UNKNOWN);
+
+    return GetUploadFormat(renderer, alpha ? SDL_TRUE : SDL_FALSE);
+}
+
+/* Counts pixel data converted on its way to a texture stored in 'format' */
+static void AddConvertedBytes(SDL_Renderer *renderer, int w, int h, Uint32 format)
+{
+    renderer->stats.converted_bytes += (Uint32)w * h * SDL_BYTESPERPIXEL(format);
 }
 
 static SDL_ScaleMode SDL_GetScaleMode(void)
@@ -1302,68 +1797,488 @@ SDL_Texture *SDL_CreateTexture(SDL_Renderer *renderer, Uint32 format, int access
     if (renderer->textures) {
         renderer->textures->prev = texture;
     }
-    renderer->textures = texture;
+    renderer->textures = texture;
+
+    /* FOURCC format cannot be used directly by renderer back-ends for target texture */
+    texture_is_fourcc_and_target = (access == SDL_TEXTUREACCESS_TARGET && SDL_ISPIXELFORMAT_FOURCC(texture->format));
+
+    if (texture_is_fourcc_and_target == SDL_FALSE && IsSupportedFormat(renderer, format)) {
+        if (renderer->CreateTexture(renderer, texture) < 0) {
+            SDL_DestroyTexture(texture);
+            return NULL;
+        }
+    } else {
+        int closest_format;
+
+        if (texture_is_fourcc_and_target == SDL_FALSE) {
+            closest_format = GetClosestSupportedFormat(renderer, format);
+        } else {
+            closest_format = renderer->info.texture_formats[0];
+        }
+
+        texture->native = SDL_CreateTexture(renderer, closest_format, access, w, h);
+        if (!texture->native) {
+            SDL_DestroyTexture(texture);
+            return NULL;
+        }
+
+        /* Swap textures to have texture before texture->native in the list */
+        texture->native->next = texture->next;
+        if (texture->native->next) {
+            texture->native->next->prev = texture->native;
+        }
+        texture->prev = texture->native->prev;
+        if (texture->prev) {
+            texture->prev->next = texture;
+        }
+        texture->native->prev = texture;
+        texture->next = texture->native;
+        renderer->textures = texture;
+
+        if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+#if SDL_HAVE_YUV
+            texture->yuv = SDL_SW_CreateYUVTexture(format, w, h);
+#else
+            SDL_SetError("SDL not built with YUV support");
+#endif
+            if (!texture->yuv) {
+                SDL_DestroyTexture(texture);
+                return NULL;
+            }
+        } else if (access == SDL_TEXTUREACCESS_STREAMING) {
+            /* The pitch is 4 byte aligned */
+            texture->pitch = (((w * SDL_BYTESPERPIXEL(format)) + 3) & ~3);
+            texture->pixels = SDL_calloc(1, (size_t)texture->pitch * h);
+            if (!texture->pixels) {
+                SDL_DestroyTexture(texture);
+                return NULL;
+            }
+        }
+    }
+    return texture;
+}
+
+/* A texture update queued by SDL_QueueTextureUpdate(). Worker threads convert
+   the surface into the format the texture is stored in, and the render thread
+   commits the result, in queue order. */
+typedef struct SDL_TextureUpload
+{
+    SDL_Texture *texture; /* NULL if the texture was destroyed meanwhile */
+    SDL_Rect rect;
+    Uint32 format;        /* the format converted to, so workers never touch the texture */
+    SDL_Surface *surface; /* freed by the render thread, surfaces aren't thread safe */
+    void *pixels;         /* NULL if the conversion failed */
+    int pitch;
+    SDL_bool converted;
+    struct SDL_TextureUpload *next;
+} SDL_TextureUpload;
+
+typedef struct SDL_UploadQueue
+{
+    SDL_mutex *lock;
+    SDL_cond *work_cond; /* signaled when an update is queued, or to quit */
+    SDL_cond *done_cond; /* signaled when an update is converted */
+    SDL_Thread **threads;
+    int num_threads;
+    SDL_bool quit;
+    SDL_bool committing; /* keeps SDL_UpdateTexture() from committing out of order */
+    SDL_TextureUpload *head;
+    SDL_TextureUpload *tail;
+    SDL_TextureUpload *next_to_convert;
+} SDL_UploadQueue;
+
+static void ConvertTextureUpload(SDL_TextureUpload *upload)
+{
+    SDL_Surface *surface = upload->surface;
+    const int w = upload->rect.w;
+    const int h = upload->rect.h;
+
+    upload->pitch = w * SDL_BYTESPERPIXEL(upload->format);
+    upload->pixels = SDL_malloc((size_t)upload->pitch * h);
+    if (upload->pixels &&
+        SDL_ConvertPixels(w, h, surface->format->format, surface->pixels, surface->pitch,
+                          upload->format, upload->pixels, upload->pitch) < 0) {
+        SDL_free(upload->pixels);
+        upload->pixels = NULL;
+    }
+}
+
+static int SDLCALL UploadThread(void *data)
+{
+    SDL_UploadQueue *queue = (SDL_UploadQueue *)data;
+
+    SDL_LockMutex(queue->lock);
+    for (;;) {
+        SDL_TextureUpload *upload;
+
+        while (!queue->quit && !queue->next_to_convert) {
+            SDL_CondWait(queue->work_cond, queue->lock);
+        }
+        if (queue->quit) {
+            break;
+        }
+        upload = queue->next_to_convert;
+        queue->next_to_convert = upload->next;
+
+        SDL_UnlockMutex(queue->lock);
+        ConvertTextureUpload(upload);
+        SDL_LockMutex(queue->lock);
+
+        upload->converted = SDL_TRUE;
+        SDL_CondBroadcast(queue->done_cond);
+    }
+    SDL_UnlockMutex(queue->lock);
+    return 0;
+}
+
+static void FreeTextureUpload(SDL_TextureUpload *upload)
+{
+    SDL_FreeSurface(upload->surface);
+    SDL_free(upload->pixels);
+    SDL_free(upload);
+}
+
+static void DestroyUploadQueue(SDL_UploadQueue *queue)
+{
+    int i;
+
+    if (!queue) {
+        return;
+    }
+
+    if (queue->lock) {
+        SDL_LockMutex(queue->lock);
+        queue->quit = SDL_TRUE;
+        SDL_CondBroadcast(queue->work_cond);
+        SDL_UnlockMutex(queue->lock);
+    }
+    for (i = 0; i < queue->num_threads; i++) {
+        SDL_WaitThread(queue->threads[i], NULL);
+    }
+    while (queue->head) {
+        SDL_TextureUpload *next = queue->head->next;
+        FreeTextureUpload(queue->head);
+        queue->head = next;
+    }
+    SDL_free(queue->threads);
+    SDL_DestroyCond(queue->done_cond);
+    SDL_DestroyCond(queue->work_cond);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue);
+}
+
+static SDL_UploadQueue *GetUploadQueue(SDL_Renderer *renderer)
+{
+    SDL_UploadQueue *queue = renderer->uploads;
+    int i, num_threads;
+
+    if (queue) {
+        return queue;
+    }
+
+    /* Leave a core for the render thread, conversion is memory bound anyway */
+    num_threads = SDL_clamp(SDL_GetCPUCount() - 1, 1, 4);
+
+    queue = (SDL_UploadQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    queue->threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(*queue->threads));
+    queue->lock = SDL_CreateMutex();
+    queue->work_cond = SDL_CreateCond();
+    queue->done_cond = SDL_CreateCond();
+    if (!queue->threads || !queue->lock || !queue->work_cond || !queue->done_cond) {
+        DestroyUploadQueue(queue);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    for (i = 0; i < num_threads; i++) {
+        queue->threads[i] = SDL_CreateThreadInternal(UploadThread, "SDLTexUpload", 0, queue);
+        if (!queue->threads[i]) {
+            break;
+        }
+        queue->num_threads++;
+    }
+    if (queue->num_threads == 0) {
+        DestroyUploadQueue(queue);
+        return NULL;
+    }
+    renderer->uploads = queue;
+    return queue;
+}
+
+static void CommitTextureUpload(SDL_Renderer *renderer, SDL_TextureUpload *upload)
+{
+    SDL_Texture *texture = upload->texture;
+
+    if (texture) {
+        texture->pending_uploads--;
+        if (upload->pixels) {
+            if (upload->surface->format->format != upload->format) {
+                AddConvertedBytes(renderer, upload->rect.w, upload->rect.h, upload->format);
+            }
+            SDL_UpdateTexture(texture, &upload->rect, upload->pixels, upload->pitch);
+            renderer->stats.uploads++;
+            renderer->stats.upload_bytes += (Uint32)upload->pitch * upload->rect.h;
+        }
+    }
+    FreeTextureUpload(upload);
+}
+
+/* Commits queued updates in order: those of 'texture', waiting for each to be
+   converted, or if 'texture' is NULL, all of them, either waiting as well or
+   stopping at the first one not converted yet or once 'budget' bytes, if not
+   0, have been committed. */
+static void CommitTextureUploads(SDL_Renderer *renderer, SDL_Texture *texture, SDL_bool wait, size_t budget)
+{
+    SDL_UploadQueue *queue = renderer->uploads;
+    SDL_TextureUpload *prev = NULL;
+    SDL_TextureUpload *upload;
+    size_t committed = 0;
+
+    if (!queue || queue->committing) {
+        return;
+    }
+    queue->committing = SDL_TRUE;
+
+    SDL_LockMutex(queue->lock);
+    upload = queue->head;
+    while (upload) {
+        SDL_TextureUpload *next;
+        size_t size;
+
+        if (texture && upload->texture != texture) {
+            prev = upload;
+            upload = upload->next;
+            continue;
+        }
+        if (!upload->converted) {
+            Uint64 start;
+
+            if (!wait) {
+                break;
+            }
+            start = SDL_GetPerformanceCounter();
+            while (!upload->converted) {
+                SDL_CondWait(queue->done_cond, queue->lock);
+            }
+            renderer->stats.upload_stalls++;
+            renderer->stats.upload_stall_us += (Uint32)((SDL_GetPerformanceCounter() - start) * 1000000 / SDL_GetPerformanceFrequency());
+        }
+        size = upload->texture ? (size_t)upload->pitch * upload->rect.h : 0;
+        if (budget && committed > 0 && committed + size > budget) {
+            break;
+        }
+        committed += size;
+
+        /* Only this thread unlinks updates, and converted ones are never
+           next_to_convert, so the list can be walked unlocked from here */
+        next = upload->next;
+        if (prev) {
+            prev->next = next;
+        } else {
+            queue->head = next;
+        }
+        if (queue->tail == upload) {
+            queue->tail = prev;
+        }
+        SDL_UnlockMutex(queue->lock);
+        CommitTextureUpload(renderer, upload);
+        SDL_LockMutex(queue->lock);
+        upload = next;
+    }
+    SDL_UnlockMutex(queue->lock);
+
+    queue->committing = SDL_FALSE;
+}
+
+/* Commits the queued updates of a texture about to be drawn, changed or read */
+static void CommitTextureUploadsIfPending(SDL_Texture *texture)
+{
+    if (texture->pending_uploads > 0) {
+        CommitTextureUploads(texture->renderer, texture, SDL_TRUE, 0);
+    }
+    if (texture->native && texture->native->pending_uploads > 0) {
+        CommitTextureUploads(texture->renderer, texture->native, SDL_TRUE, 0);
+    }
+}
+
+/* Drops the queued updates of a texture being destroyed */
+static void CancelTextureUploads(SDL_Texture *texture)
+{
+    SDL_UploadQueue *queue = texture->renderer->uploads;
+    SDL_TextureUpload *upload;
+
+    if (!queue || texture->pending_uploads == 0) {
+        return;
+    }
+    SDL_LockMutex(queue->lock);
+    for (upload = queue->head; upload; upload = upload->next) {
+        if (upload->texture == texture) {
+            upload->texture = NULL;
+        }
+    }
+    SDL_UnlockMutex(queue->lock);
+    texture->pending_uploads = 0;
+}
+
+static int CountTextureUploads(SDL_Renderer *renderer)
+{
+    SDL_UploadQueue *queue = renderer->uploads;
+    SDL_TextureUpload *upload;
+    int count = 0;
+
+    if (!queue) {
+        return 0;
+    }
+    SDL_LockMutex(queue->lock);
+    for (upload = queue->head; upload; upload = upload->next) {
+        if (upload->texture) {
+            count++;
+        }
+    }
+    SDL_UnlockMutex(queue->lock);
+    return count;
+}
+
+int SDL_QueueTextureUpdate(SDL_Texture *texture, const SDL_Rect *rect, SDL_Surface *surface)
+{
+    SDL_Renderer *renderer;
+    SDL_UploadQueue *queue;
+    SDL_TextureUpload *upload;
+    SDL_Texture *dst;
+    SDL_Rect real_rect;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format) || SDL_ISPIXELFORMAT_INDEXED(texture->format)) {
+        return SDL_SetError("SDL_QueueTextureUpdate(): YUV and palettized textures are not supported");
+    }
+
+    real_rect.x = 0;
+    real_rect.y = 0;
+    real_rect.w = texture->w;
+    real_rect.h = texture->h;
+    if (rect) {
+        if (!SDL_IntersectRect(rect, &real_rect, &real_rect)) {
+            return 0;
+        }
+    }
+    if (real_rect.w > surface->w || real_rect.h > surface->h) {
+        return SDL_SetError("SDL_QueueTextureUpdate(): surface is smaller than the area to update");
+    }
 
-    /* FOURCC format cannot be used directly by renderer back-ends for target texture */
-    texture_is_fourcc_and_target = (access == SDL_TEXTUREACCESS_TARGET && SDL_ISPIXELFORMAT_FOURCC(texture->format));
+    /* Streaming textures keep a copy of their pixels in their own format */
+    renderer = texture->renderer;
+    dst = texture;
+    if (texture->native && texture->access != SDL_TEXTUREACCESS_STREAMING) {
+        dst = texture->native;
+    }
 
-    if (texture_is_fourcc_and_target == SDL_FALSE && IsSupportedFormat(renderer, format)) {
-        if (renderer->CreateTexture(renderer, texture) < 0) {
-            SDL_DestroyTexture(texture);
-            return NULL;
-        }
-    } else {
-        int closest_format;
+    if (SDL_MUSTLOCK(surface) || SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
+        /* SDL_ConvertPixels() can't read these, convert them here */
+        SDL_Surface *temp = SDL_ConvertSurfaceFormat(surface, dst->format, 0);
+        int retval;
 
-        if (texture_is_fourcc_and_target == SDL_FALSE) {
-            closest_format = GetClosestSupportedFormat(renderer, format);
-        } else {
-            closest_format = renderer->info.texture_formats[0];
+        if (!temp) {
+            return -1;
         }
+        AddConvertedBytes(renderer, temp->w, temp->h, dst->format);
+        retval = SDL_QueueTextureUpdate(texture, &real_rect, temp);
+        SDL_FreeSurface(temp);
+        return retval;
+    }
 
-        texture->native = SDL_CreateTexture(renderer, closest_format, access, w, h);
-        if (!texture->native) {
-            SDL_DestroyTexture(texture);
-            return NULL;
-        }
+    if (dst == renderer->target) {
+        /* Draws to it are queued already, so it can't wait */
+        const int pitch = real_rect.w * SDL_BYTESPERPIXEL(dst->format);
+        void *pixels = SDL_malloc((size_t)pitch * real_rect.h);
+        int retval;
 
-        /* Swap textures to have texture before texture->native in the list */
-        texture->native->next = texture->next;
-        if (texture->native->next) {
-            texture->native->next->prev = texture->native;
+        if (!pixels) {
+            return SDL_OutOfMemory();
         }
-        texture->prev = texture->native->prev;
-        if (texture->prev) {
-            texture->prev->next = texture;
+        if (surface->format->format != dst->format) {
+            AddConvertedBytes(renderer, real_rect.w, real_rect.h, dst->format);
         }
-        texture->native->prev = texture;
-        texture->next = texture->native;
-        renderer->textures = texture;
-
-        if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
-#if SDL_HAVE_YUV
-            texture->yuv = SDL_SW_CreateYUVTexture(format, w, h);
-#else
-            SDL_SetError("SDL not built with YUV support");
-#endif
-            if (!texture->yuv) {
-                SDL_DestroyTexture(texture);
-                return NULL;
-            }
-        } else if (access == SDL_TEXTUREACCESS_STREAMING) {
-            /* The pitch is 4 byte aligned */
-            texture->pitch = (((w * SDL_BYTESPERPIXEL(format)) + 3) & ~3);
-            texture->pixels = SDL_calloc(1, (size_t)texture->pitch * h);
-            if (!texture->pixels) {
-                SDL_DestroyTexture(texture);
-                return NULL;
-            }
+        retval = SDL_ConvertPixels(real_rect.w, real_rect.h, surface->format->format, surface->pixels, surface->pitch,
+                                   dst->format, pixels, pitch);
+        if (retval == 0) {
+            retval = SDL_UpdateTexture(dst, &real_rect, pixels, pitch);
         }
+        SDL_free(pixels);
+        return retval;
     }
-    return texture;
+
+    queue = GetUploadQueue(renderer);
+    if (!queue) {
+        return -1;
+    }
+    upload = (SDL_TextureUpload *)SDL_calloc(1, sizeof(*upload));
+    if (!upload) {
+        return SDL_OutOfMemory();
+    }
+    upload->texture = dst;
+    upload->rect = real_rect;
+    upload->format = dst->format;
+    upload->surface = surface;
+    ++surface->refcount;
+    dst->pending_uploads++;
+
+    SDL_LockMutex(queue->lock);
+    if (queue->tail) {
+        queue->tail->next = upload;
+    } else {
+        queue->head = upload;
+    }
+    queue->tail = upload;
+    if (!queue->next_to_convert) {
+        queue->next_to_convert = upload;
+    }
+    SDL_CondSignal(queue->work_cond);
+    SDL_UnlockMutex(queue->lock);
+    return 0;
 }
 
-SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface)
+int SDL_SetTextureUploadBudget(SDL_Renderer *renderer, int bytes)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (bytes < 0) {
+        return SDL_InvalidParamError("bytes");
+    }
+    renderer->upload_budget = (size_t)bytes;
+    return 0;
+}
+
+int SDL_FlushTextureUpdates(SDL_Renderer *renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    CommitTextureUploads(renderer, NULL, SDL_TRUE, 0);
+    return 0;
+}
+
+/* Lets a texture created from a surface in its format use the surface pixels,
+   if the renderer can and SDL_HINT_RENDER_SHARE_SURFACE_PIXELS allows it.
+   Surfaces with pixels the app allocated aren't shared, those may be freed
+   along with the surface, and neither are ones with RLE acceleration, since
+   encoding them frees the pixels. */
+static SDL_bool ShareSurfacePixels(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Surface *surface)
+{
+    if (!renderer->ShareTexturePixels || texture->native ||
+        SDL_MUSTLOCK(surface) || (surface->flags & SDL_PREALLOC) || SDL_HasSurfaceRLE(surface) ||
+        !SDL_GetHintBoolean(SDL_HINT_RENDER_SHARE_SURFACE_PIXELS, SDL_FALSE)) {
+        return SDL_FALSE;
+    }
+    return (renderer->ShareTexturePixels(renderer, texture, surface) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+static SDL_Texture *CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface, SDL_bool async)
 {
     const SDL_PixelFormat *fmt;
     SDL_bool needAlpha;
@@ -1426,14 +2341,7 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
 
     /* Fallback, choose a valid pixel format */
     if (format == SDL_PIXELFORMAT_UNKNOWN) {
-        format = renderer->info.texture_formats[0];
-        for (i = 0; i < (int)renderer->info.num_texture_formats; ++i) {
-            if (!SDL_ISPIXELFORMAT_FOURCC(renderer->info.texture_formats[i]) &&
-                SDL_ISPIXELFORMAT_ALPHA(renderer->info.texture_formats[i]) == needAlpha) {
-                format = renderer->info.texture_formats[i];
-                break;
-            }
-        }
+        format = GetUploadFormat(renderer, needAlpha);
     }
 
     texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC,
@@ -1457,7 +2365,14 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
     }
 
     if (direct_update) {
-        if (SDL_MUSTLOCK(surface)) {
+        if (ShareSurfacePixels(renderer, texture, surface)) {
+            /* Nothing to upload */
+        } else if (async) {
+            if (SDL_QueueTextureUpdate(texture, NULL, surface) < 0) {
+                SDL_DestroyTexture(texture);
+                return NULL;
+            }
+        } else if (SDL_MUSTLOCK(surface)) {
             SDL_LockSurface(surface);
             SDL_UpdateTexture(texture, NULL, surface->pixels, surface->pitch);
             SDL_UnlockSurface(surface);
@@ -1476,6 +2391,12 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
         }
 #endif
 
+    } else if (async && !fmt->palette && !SDL_HasColorKey(surface) && !SDL_MUSTLOCK(surface)) {
+        /* A plain pixel format conversion, which a worker thread can do */
+        if (SDL_QueueTextureUpdate(texture, NULL, surface) < 0) {
+            SDL_DestroyTexture(texture);
+            return NULL;
+        }
     } else {
         SDL_PixelFormat *dst_fmt;
         SDL_Surface *temp = NULL;
@@ -1489,7 +2410,16 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
         temp = SDL_ConvertSurface(surface, dst_fmt, 0);
         SDL_FreeFormat(dst_fmt);
         if (temp) {
-            SDL_UpdateTexture(texture, NULL, temp->pixels, temp->pitch);
+            AddConvertedBytes(renderer, temp->w, temp->h, format);
+            if (async) {
+                if (SDL_QueueTextureUpdate(texture, NULL, temp) < 0) {
+                    SDL_FreeSurface(temp);
+                    SDL_DestroyTexture(texture);
+                    return NULL;
+                }
+            } else {
+                SDL_UpdateTexture(texture, NULL, temp->pixels, temp->pitch);
+            }
             SDL_FreeSurface(temp);
         } else {
             SDL_DestroyTexture(texture);
@@ -1518,6 +2448,16 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
     return texture;
 }
 
+SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface)
+{
+    return CreateTextureFromSurface(renderer, surface, SDL_FALSE);
+}
+
+SDL_Texture *SDL_CreateTextureFromSurfaceAsync(SDL_Renderer *renderer, SDL_Surface *surface)
+{
+    return CreateTextureFromSurface(renderer, surface, SDL_TRUE);
+}
+
 int SDL_QueryTexture(SDL_Texture *texture, Uint32 *format, int *access,
                      int *w, int *h)
 {
@@ -1667,6 +2607,42 @@ void *SDL_GetTextureUserData(SDL_Texture *texture)
     return texture->userdata;
 }
 
+int SDL_SetTextureDamageTracking(SDL_Texture *texture, SDL_bool enabled)
+{
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (texture->access != SDL_TEXTUREACCESS_TARGET) {
+        return SDL_SetError("Texture not created with SDL_TEXTUREACCESS_TARGET");
+    }
+    if (texture->native) {
+        /* Draws go to the native texture */
+        texture = texture->native;
+    }
+
+    texture->track_damage = enabled;
+    SDL_zero(texture->damage);
+    return 0;
+}
+
+int SDL_GetTextureDamage(SDL_Texture *texture, SDL_Rect *rect)
+{
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!rect) {
+        return SDL_InvalidParamError("rect");
+    }
+    if (texture->native) {
+        texture = texture->native;
+    }
+    if (!texture->track_damage) {
+        return SDL_SetError("Damage tracking is not enabled for this texture");
+    }
+
+    *rect = texture->damage;
+    SDL_zero(texture->damage);
+    return 0;
+}
+
 #if SDL_HAVE_YUV
 static int SDL_UpdateTextureYUV(SDL_Texture *texture, const SDL_Rect *rect,
                                 const void *pixels, int pitch)
@@ -1684,6 +2660,8 @@ static int SDL_UpdateTextureYUV(SDL_Texture *texture, const SDL_Rect *rect,
     full_rect.h = texture->h;
     rect = &full_rect;
 
+    AddConvertedBytes(texture->renderer, rect->w, rect->h, native->format);
+
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         /* We can lock the texture and copy to it */
         void *native_pixels = NULL;
@@ -1723,6 +2701,8 @@ static int SDL_UpdateTextureNative(SDL_Texture *texture, const SDL_Rect *rect,
         return 0; /* nothing to do. */
     }
 
+    AddConvertedBytes(texture->renderer, rect->w, rect->h, native->format);
+
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         /* We can lock the texture and copy to it */
         void *native_pixels = NULL;
@@ -1778,6 +2758,9 @@ int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect,
         }
     }
 
+    /* Queued updates go first, so this one isn't overwritten */
+    CommitTextureUploadsIfPending(texture);
+
     if (real_rect.w == 0 || real_rect.h == 0) {
         return 0; /* nothing to do. */
 #if SDL_HAVE_YUV
@@ -1791,6 +2774,9 @@ int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect,
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        if (texture->track_damage) {
+            AddDamage(&texture->damage, &real_rect);
+        }
         return renderer->UpdateTexture(renderer, texture, &real_rect, pixels, pitch);
     }
 }
@@ -1818,6 +2804,8 @@ static int SDL_UpdateTextureYUVPlanar(SDL_Texture *texture, const SDL_Rect *rect
         return 0; /* nothing to do. */
     }
 
+    AddConvertedBytes(texture->renderer, rect->w, rect->h, native->format);
+
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         /* We can lock the texture and copy to it */
         void *native_pixels = NULL;
@@ -1868,6 +2856,8 @@ static int SDL_UpdateTextureNVPlanar(SDL_Texture *texture, const SDL_Rect *rect,
         return 0; /* nothing to do. */
     }
 
+    AddConvertedBytes(texture->renderer, rect->w, rect->h, native->format);
+
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         /* We can lock the texture and copy to it */
         void *native_pixels = NULL;
@@ -2056,6 +3046,8 @@ int SDL_LockTexture(SDL_Texture *texture, const SDL_Rect *rect,
         return SDL_SetError("SDL_LockTexture(): texture must be streaming");
     }
 
+    CommitTextureUploadsIfPending(texture);
+
     if (!rect) {
         full_rect.x = 0;
         full_rect.y = 0;
@@ -2132,6 +3124,8 @@ static void SDL_UnlockTextureYUV(SDL_Texture *texture)
     rect.w = texture->w;
     rect.h = texture->h;
 
+    AddConvertedBytes(texture->renderer, rect.w, rect.h, native->format);
+
     if (SDL_LockTexture(native, &rect, &native_pixels, &native_pitch) < 0) {
         return;
     }
@@ -2152,6 +3146,8 @@ static void SDL_UnlockTextureNative(SDL_Texture *texture)
                                   rect->x * SDL_BYTESPERPIXEL(texture->format));
     int pitch = texture->pitch;
 
+    AddConvertedBytes(texture->renderer, rect->w, rect->h, native->format);
+
     if (SDL_LockTexture(native, rect, &native_pixels, &native_pitch) < 0) {
         return;
     }
@@ -2211,6 +3207,7 @@ int SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
             /* Always render to the native texture */
             texture = texture->native;
         }
+        CommitTextureUploadsIfPending(texture);
     }
 
     if (texture == renderer->target) {
@@ -2220,6 +3217,8 @@ int SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
 
     FlushRenderCommands(renderer); /* time to send everything to the GPU! */
 
+    renderer->stats.target_switches++;
+
     SDL_LockMutex(renderer->target_mutex);
 
     if (texture && !renderer->target) {
@@ -2665,7 +3664,6 @@ static int RenderDrawPointsWithRects(SDL_Renderer *renderer,
                                      const SDL_Point *points, const int count)
 {
     int retval;
-    SDL_bool isstack;
     SDL_FRect *frects;
     int i;
 
@@ -2673,7 +3671,7 @@ static int RenderDrawPointsWithRects(SDL_Renderer *renderer,
         return 0;
     }
 
-    frects = SDL_small_alloc(SDL_FRect, count, &isstack);
+    frects = (SDL_FRect *)AllocateRenderScratch(renderer, count * sizeof(SDL_FRect));
     if (!frects) {
         return SDL_OutOfMemory();
     }
@@ -2687,7 +3685,7 @@ static int RenderDrawPointsWithRects(SDL_Renderer *renderer,
 
     retval = QueueCmdFillRects(renderer, frects, count);
 
-    SDL_small_free(frects, isstack);
+    FreeRenderScratch(renderer, frects, count * sizeof(SDL_FRect));
 
     return retval;
 }
@@ -2698,7 +3696,6 @@ int SDL_RenderDrawPoints(SDL_Renderer *renderer,
     SDL_FPoint *fpoints;
     int i;
     int retval;
-    SDL_bool isstack;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -2719,7 +3716,7 @@ int SDL_RenderDrawPoints(SDL_Renderer *renderer,
     if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
         retval = RenderDrawPointsWithRects(renderer, points, count);
     } else {
-        fpoints = SDL_small_alloc(SDL_FPoint, count, &isstack);
+        fpoints = (SDL_FPoint *)AllocateRenderScratch(renderer, count * sizeof(SDL_FPoint));
         if (!fpoints) {
             return SDL_OutOfMemory();
         }
@@ -2730,7 +3727,7 @@ int SDL_RenderDrawPoints(SDL_Renderer *renderer,
 
         retval = QueueCmdDrawPoints(renderer, fpoints, count);
 
-        SDL_small_free(fpoints, isstack);
+        FreeRenderScratch(renderer, fpoints, count * sizeof(SDL_FPoint));
     }
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
@@ -2739,7 +3736,6 @@ static int RenderDrawPointsWithRectsF(SDL_Renderer *renderer,
                                       const SDL_FPoint *fpoints, const int count)
 {
     int retval;
-    SDL_bool isstack;
     SDL_FRect *frects;
     int i;
 
@@ -2747,7 +3743,7 @@ static int RenderDrawPointsWithRectsF(SDL_Renderer *renderer,
         return 0;
     }
 
-    frects = SDL_small_alloc(SDL_FRect, count, &isstack);
+    frects = (SDL_FRect *)AllocateRenderScratch(renderer, count * sizeof(SDL_FRect));
     if (!frects) {
         return SDL_OutOfMemory();
     }
@@ -2761,7 +3757,7 @@ static int RenderDrawPointsWithRectsF(SDL_Renderer *renderer,
 
     retval = QueueCmdFillRects(renderer, frects, count);
 
-    SDL_small_free(frects, isstack);
+    FreeRenderScratch(renderer, frects, count * sizeof(SDL_FRect));
 
     return retval;
 }
@@ -2822,7 +3818,6 @@ static int RenderDrawLineBresenham(SDL_Renderer *renderer, int x1, int y1, int x
     int x, xinc1, xinc2;
     int y, yinc1, yinc2;
     int retval;
-    SDL_bool isstack;
     SDL_FPoint *points;
     SDL_Rect clip_rect;
 
@@ -2876,7 +3871,7 @@ static int RenderDrawLineBresenham(SDL_Renderer *renderer, int x1, int y1, int x
         --numpixels;
     }
 
-    points = SDL_small_alloc(SDL_FPoint, numpixels, &isstack);
+    points = (SDL_FPoint *)AllocateRenderScratch(renderer, numpixels * sizeof(SDL_FPoint));
     if (!points) {
         return SDL_OutOfMemory();
     }
@@ -2901,7 +3896,7 @@ static int RenderDrawLineBresenham(SDL_Renderer *renderer, int x1, int y1, int x
         retval = QueueCmdDrawPoints(renderer, points, numpixels);
     }
 
-    SDL_small_free(points, isstack);
+    FreeRenderScratch(renderer, points, numpixels * sizeof(SDL_FPoint));
 
     return retval;
 }
@@ -2915,11 +3910,10 @@ static int RenderDrawLinesWithRectsF(SDL_Renderer *renderer,
     SDL_FRect *frects;
     int i, nrects = 0;
     int retval = 0;
-    SDL_bool isstack;
     SDL_bool drew_line = SDL_FALSE;
     SDL_bool draw_last = SDL_FALSE;
 
-    frects = SDL_small_alloc(SDL_FRect, count - 1, &isstack);
+    frects = (SDL_FRect *)AllocateRenderScratch(renderer, (count - 1) * sizeof(SDL_FRect));
     if (!frects) {
         return SDL_OutOfMemory();
     }
@@ -2972,7 +3966,7 @@ static int RenderDrawLinesWithRectsF(SDL_Renderer *renderer,
         retval += QueueCmdFillRects(renderer, frects, nrects);
     }
 
-    SDL_small_free(frects, isstack);
+    FreeRenderScratch(renderer, frects, (count - 1) * sizeof(SDL_FRect));
 
     if (retval < 0) {
         retval = -1;
@@ -2986,7 +3980,6 @@ int SDL_RenderDrawLines(SDL_Renderer *renderer,
     SDL_FPoint *fpoints;
     int i;
     int retval;
-    SDL_bool isstack;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -3004,7 +3997,7 @@ int SDL_RenderDrawLines(SDL_Renderer *renderer,
     }
 #endif
 
-    fpoints = SDL_small_alloc(SDL_FPoint, count, &isstack);
+    fpoints = (SDL_FPoint *)AllocateRenderScratch(renderer, count * sizeof(SDL_FPoint));
     if (!fpoints) {
         return SDL_OutOfMemory();
     }
@@ -3016,7 +4009,7 @@ int SDL_RenderDrawLines(SDL_Renderer *renderer,
 
     retval = SDL_RenderDrawLinesF(renderer, fpoints, count);
 
-    SDL_small_free(fpoints, isstack);
+    FreeRenderScratch(renderer, fpoints, count * sizeof(SDL_FPoint));
 
     return retval;
 }
@@ -3045,13 +4038,12 @@ int SDL_RenderDrawLinesF(SDL_Renderer *renderer,
     if (renderer->line_method == SDL_RENDERLINEMETHOD_POINTS) {
         retval = RenderDrawLinesWithRectsF(renderer, points, count);
     } else if (renderer->line_method == SDL_RENDERLINEMETHOD_GEOMETRY) {
-        SDL_bool isstack1;
-        SDL_bool isstack2;
         const float scale_x = renderer->scale.x;
         const float scale_y = renderer->scale.y;
-        float *xy = SDL_small_alloc(float, 4 * 2 * count, &isstack1);
-        int *indices = SDL_small_alloc(int,
-                                       (4) * 3 * (count - 1) + (2) * 3 * (count), &isstack2);
+        const size_t xy_size = 4 * 2 * count * sizeof(float);
+        const size_t indices_size = ((4) * 3 * (count - 1) + (2) * 3 * (count)) * sizeof(int);
+        float *xy = (float *)AllocateRenderScratch(renderer, xy_size);
+        int *indices = (int *)AllocateRenderScratch(renderer, indices_size);
 
         if (xy && indices) {
             int i;
@@ -3161,8 +4153,8 @@ int SDL_RenderDrawLinesF(SDL_Renderer *renderer,
                                       1.0f, 1.0f);
         }
 
-        SDL_small_free(xy, isstack1);
-        SDL_small_free(indices, isstack2);
+        FreeRenderScratch(renderer, xy, xy_size);
+        FreeRenderScratch(renderer, indices, indices_size);
 
     } else if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
         retval = RenderDrawLinesWithRectsF(renderer, points, count);
@@ -3311,7 +4303,6 @@ int SDL_RenderFillRects(SDL_Renderer *renderer,
     SDL_FRect *frects;
     int i;
     int retval;
-    SDL_bool isstack;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -3329,7 +4320,7 @@ int SDL_RenderFillRects(SDL_Renderer *renderer,
     }
 #endif
 
-    frects = SDL_small_alloc(SDL_FRect, count, &isstack);
+    frects = (SDL_FRect *)AllocateRenderScratch(renderer, count * sizeof(SDL_FRect));
     if (!frects) {
         return SDL_OutOfMemory();
     }
@@ -3342,7 +4333,7 @@ int SDL_RenderFillRects(SDL_Renderer *renderer,
 
     retval = QueueCmdFillRects(renderer, frects, count);
 
-    SDL_small_free(frects, isstack);
+    FreeRenderScratch(renderer, frects, count * sizeof(SDL_FRect));
 
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
@@ -3353,7 +4344,6 @@ int SDL_RenderFillRectsF(SDL_Renderer *renderer,
     SDL_FRect *frects;
     int i;
     int retval;
-    SDL_bool isstack;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -3371,7 +4361,7 @@ int SDL_RenderFillRectsF(SDL_Renderer *renderer,
     }
 #endif
 
-    frects = SDL_small_alloc(SDL_FRect, count, &isstack);
+    frects = (SDL_FRect *)AllocateRenderScratch(renderer, count * sizeof(SDL_FRect));
     if (!frects) {
         return SDL_OutOfMemory();
     }
@@ -3384,7 +4374,7 @@ int SDL_RenderFillRectsF(SDL_Renderer *renderer,
 
     retval = QueueCmdFillRects(renderer, frects, count);
 
-    SDL_small_free(frects, isstack);
+    FreeRenderScratch(renderer, frects, count * sizeof(SDL_FRect));
 
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
@@ -3418,6 +4408,7 @@ int SDL_RenderCopyF(SDL_Renderer *renderer, SDL_Texture *texture,
     if (renderer != texture->renderer) {
         return SDL_SetError("Texture was not created with this renderer");
     }
+    CommitTextureUploadsIfPending(texture);
 
 #if DONT_DRAW_WHILE_HIDDEN
     /* Don't draw while we're hidden */
@@ -3509,6 +4500,284 @@ int SDL_RenderCopyF(SDL_Renderer *renderer, SDL_Texture *texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+#if defined(__SSE2__)
+#define HAVE_SSE2_INTRINSICS
+#endif
+
+/* vdivq_f32() only exists on 64-bit ARM */
+#if defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+/* Writes the four corners of a copy, in the same order and with the same
+ * rounding as SDL_RenderCopyF(): xy and uv each get 8 floats. */
+typedef void (*SDL_CopyVerticesFunc)(float *xy, float *uv, const SDL_Rect *srcrect, const SDL_FRect *dstrect, const float *texsize);
+
+static void BuildCopyVertices(float *xy, float *uv, const SDL_Rect *srcrect, const SDL_FRect *dstrect, const float *texsize)
+{
+    const float minu = (float)(srcrect->x) / texsize[0];
+    const float minv = (float)(srcrect->y) / texsize[1];
+    const float maxu = (float)(srcrect->x + srcrect->w) / texsize[0];
+    const float maxv = (float)(srcrect->y + srcrect->h) / texsize[1];
+    const float minx = dstrect->x;
+    const float miny = dstrect->y;
+    const float maxx = dstrect->x + dstrect->w;
+    const float maxy = dstrect->y + dstrect->h;
+
+    uv[0] = minu;
+    uv[1] = minv;
+    uv[2] = maxu;
+    uv[3] = minv;
+    uv[4] = maxu;
+    uv[5] = maxv;
+    uv[6] = minu;
+    uv[7] = maxv;
+
+    xy[0] = minx;
+    xy[1] = miny;
+    xy[2] = maxx;
+    xy[3] = miny;
+    xy[4] = maxx;
+    xy[5] = maxy;
+    xy[6] = minx;
+    xy[7] = maxy;
+}
+
+#if defined(HAVE_SSE2_INTRINSICS)
+static SDL_INLINE int hasSSE2(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasSSE2();
+    return val;
+}
+
+static void BuildCopyVertices_SSE2(float *xy, float *uv, const SDL_Rect *srcrect, const SDL_FRect *dstrect, const float *texsize)
+{
+    /* (x, y, w, h) -> (x, y, x + w, y + h) */
+    const __m128i src = _mm_loadu_si128((const __m128i *)srcrect);
+    const __m128i src_box = _mm_add_epi32(_mm_unpacklo_epi64(src, src), _mm_unpackhi_epi64(_mm_setzero_si128(), src));
+    const __m128 tex = _mm_div_ps(_mm_cvtepi32_ps(src_box), _mm_loadu_ps(texsize));
+    const __m128 dst = _mm_loadu_ps(&dstrect->x);
+    const __m128 dst_box = _mm_add_ps(_mm_movelh_ps(dst, dst), _mm_movelh_ps(_mm_setzero_ps(), _mm_movehl_ps(dst, dst)));
+
+    /* (min, min, max, min), (max, max, min, max) */
+    _mm_storeu_ps(uv, _mm_shuffle_ps(tex, tex, _MM_SHUFFLE(1, 2, 1, 0)));
+    _mm_storeu_ps(uv + 4, _mm_shuffle_ps(tex, tex, _MM_SHUFFLE(3, 0, 3, 2)));
+    _mm_storeu_ps(xy, _mm_shuffle_ps(dst_box, dst_box, _MM_SHUFFLE(1, 2, 1, 0)));
+    _mm_storeu_ps(xy + 4, _mm_shuffle_ps(dst_box, dst_box, _MM_SHUFFLE(3, 0, 3, 2)));
+}
+#endif
+
+#if defined(HAVE_NEON_INTRINSICS)
+static SDL_INLINE int hasNEON(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasNEON();
+    return val;
+}
+
+static void BuildCopyVertices_NEON(float *xy, float *uv, const SDL_Rect *srcrect, const SDL_FRect *dstrect, const float *texsize)
+{
+    /* (x, y, w, h) -> (x, y, x + w, y + h) */
+    const int32x4_t src = vld1q_s32((const int32_t *)srcrect);
+    const int32x4_t src_box = vaddq_s32(vcombine_s32(vget_low_s32(src), vget_low_s32(src)), vcombine_s32(vdup_n_s32(0), vget_high_s32(src)));
+    const float32x4_t tex = vdivq_f32(vcvtq_f32_s32(src_box), vld1q_f32(texsize));
+    const float32x4_t dst = vld1q_f32(&dstrect->x);
+    const float32x4_t dst_box = vaddq_f32(vcombine_f32(vget_low_f32(dst), vget_low_f32(dst)), vcombine_f32(vdup_n_f32(0.0f), vget_high_f32(dst)));
+
+    /* (min, min, max, min), (max, max, min, max) */
+    vst1q_f32(uv, vcombine_f32(vget_low_f32(tex), vset_lane_f32(vgetq_lane_f32(tex, 1), vget_high_f32(tex), 1)));
+    vst1q_f32(uv + 4, vcombine_f32(vget_high_f32(tex), vset_lane_f32(vgetq_lane_f32(tex, 3), vget_low_f32(tex), 1)));
+    vst1q_f32(xy, vcombine_f32(vget_low_f32(dst_box), vset_lane_f32(vgetq_lane_f32(dst_box, 1), vget_high_f32(dst_box), 1)));
+    vst1q_f32(xy + 4, vcombine_f32(vget_high_f32(dst_box), vset_lane_f32(vgetq_lane_f32(dst_box, 3), vget_low_f32(dst_box), 1)));
+}
+#endif
+
+static SDL_CopyVerticesFunc GetCopyVerticesFunc(void)
+{
+#if defined(HAVE_NEON_INTRINSICS)
+    if (hasNEON()) {
+        return BuildCopyVertices_NEON;
+    }
+#endif
+#if defined(HAVE_SSE2_INTRINSICS)
+    if (hasSSE2()) {
+        return BuildCopyVertices_SSE2;
+    }
+#endif
+    return BuildCopyVertices;
+}
+
+/* Clips a copy of a batch like SDL_RenderCopyF() does, returns SDL_FALSE if
+ * nothing of it would be drawn */
+static SDL_bool GetBatchCopyRect(SDL_Texture *texture, const SDL_Rect *srcrects, const SDL_FRect *dstrects, const SDL_FRect *viewport,
+                                 int i, SDL_Rect *srcrect)
+{
+    srcrect->x = 0;
+    srcrect->y = 0;
+    srcrect->w = texture->w;
+    srcrect->h = texture->h;
+    if (srcrects && !SDL_IntersectRect(&srcrects[i], srcrect, srcrect)) {
+        return SDL_FALSE;
+    }
+    return SDL_HasIntersectionF(&dstrects[i], viewport);
+}
+
+/* Queues all the copies of a batch as one list of triangles */
+static int QueueCmdCopyBatch(SDL_Renderer *renderer, SDL_Texture *texture,
+                             const SDL_Rect *srcrects, const SDL_FRect *dstrects,
+                             const SDL_Color *colors, int count)
+{
+    const SDL_CopyVerticesFunc build_vertices = GetCopyVerticesFunc();
+    const size_t xy_size = 8 * count * sizeof(float);
+    const size_t indices_size = 6 * count * sizeof(int);
+    const size_t colors_size = colors ? 4 * count * sizeof(SDL_Color) : 0;
+    float *xy = (float *)AllocateRenderScratch(renderer, xy_size);
+    float *uv = (float *)AllocateRenderScratch(renderer, xy_size);
+    int *indices = (int *)AllocateRenderScratch(renderer, indices_size);
+    SDL_Color *vertex_colors = colors ? (SDL_Color *)AllocateRenderScratch(renderer, colors_size) : NULL;
+    const int *rect_index_order = renderer->rect_index_order;
+    SDL_FRect viewport;
+    float texsize[4];
+    int num_quads = 0;
+    int retval = 0;
+    int i;
+
+    if (!xy || !uv || !indices || (colors && !vertex_colors)) {
+        retval = -1;
+        goto done;
+    }
+
+    RenderGetViewportSize(renderer, &viewport);
+    texsize[0] = texsize[2] = (float)texture->w;
+    texsize[1] = texsize[3] = (float)texture->h;
+
+    for (i = 0; i < count; ++i) {
+        const int cur_index = 4 * num_quads;
+        int *ptr_indices = &indices[6 * num_quads];
+        SDL_Rect srcrect;
+
+        if (!GetBatchCopyRect(texture, srcrects, dstrects, &viewport, i, &srcrect)) {
+            continue;
+        }
+
+        build_vertices(&xy[8 * num_quads], &uv[8 * num_quads], &srcrect, &dstrects[i], texsize);
+
+        ptr_indices[0] = cur_index + rect_index_order[0];
+        ptr_indices[1] = cur_index + rect_index_order[1];
+        ptr_indices[2] = cur_index + rect_index_order[2];
+        ptr_indices[3] = cur_index + rect_index_order[3];
+        ptr_indices[4] = cur_index + rect_index_order[4];
+        ptr_indices[5] = cur_index + rect_index_order[5];
+
+        if (vertex_colors) {
+            SDL_Color *ptr_colors = &vertex_colors[4 * num_quads];
+            ptr_colors[0] = ptr_colors[1] = ptr_colors[2] = ptr_colors[3] = colors[i];
+        }
+        ++num_quads;
+    }
+
+    if (num_quads > 0) {
+        retval = QueueCmdGeometry(renderer, texture,
+                                  xy, 2 * sizeof(float),
+                                  vertex_colors ? vertex_colors : &texture->color, vertex_colors ? sizeof(SDL_Color) : 0,
+                                  uv, 2 * sizeof(float),
+                                  4 * num_quads,
+                                  indices, 6 * num_quads, 4,
+                                  renderer->scale.x, renderer->scale.y);
+    }
+
+done:
+    FreeRenderScratch(renderer, vertex_colors, colors_size);
+    FreeRenderScratch(renderer, indices, indices_size);
+    FreeRenderScratch(renderer, uv, xy_size);
+    FreeRenderScratch(renderer, xy, xy_size);
+    return retval;
+}
+
+/* Backends with their own copy command take one color per command, so each
+ * copy is queued on its own; copies sharing a color merge into one command. */
+static int QueueCmdCopies(SDL_Renderer *renderer, SDL_Texture *texture,
+                          const SDL_Rect *srcrects, const SDL_FRect *dstrects,
+                          const SDL_Color *colors, int count)
+{
+    const SDL_Color color = texture->color;
+    SDL_FRect viewport;
+    int retval = 0;
+    int i;
+
+    RenderGetViewportSize(renderer, &viewport);
+
+    for (i = 0; i < count && retval == 0; ++i) {
+        SDL_Rect srcrect;
+        SDL_FRect dstrect;
+
+        if (!GetBatchCopyRect(texture, srcrects, dstrects, &viewport, i, &srcrect)) {
+            continue;
+        }
+
+        dstrect.x = dstrects[i].x * renderer->scale.x;
+        dstrect.y = dstrects[i].y * renderer->scale.y;
+        dstrect.w = dstrects[i].w * renderer->scale.x;
+        dstrect.h = dstrects[i].h * renderer->scale.y;
+
+        if (colors) {
+            texture->color = colors[i];
+        }
+        retval = QueueCmdCopy(renderer, texture, &srcrect, &dstrect);
+    }
+
+    texture->color = color;
+    return retval;
+}
+
+int SDL_RenderCopyBatch(SDL_Renderer *renderer, SDL_Texture *texture,
+                        const SDL_Rect *srcrects, const SDL_FRect *dstrects,
+                        const SDL_Color *colors, int count)
+{
+    int retval;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    CommitTextureUploadsIfPending(texture);
+    if (!dstrects) {
+        return SDL_InvalidParamError("dstrects");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+#endif
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    texture->last_command_generation = renderer->render_command_generation;
+
+    if (!renderer->QueueCopy) {
+        retval = QueueCmdCopyBatch(renderer, texture, srcrects, dstrects, colors, count);
+    } else {
+        retval = QueueCmdCopies(renderer, texture, srcrects, dstrects, colors, count);
+    }
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
 int SDL_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
                      const SDL_Rect *srcrect, const SDL_Rect *dstrect,
                      const double angle, const SDL_Point *center, const SDL_RendererFlip flip)
@@ -3555,6 +4824,7 @@ int SDL_RenderCopyExF(SDL_Renderer *renderer, SDL_Texture *texture,
     if (renderer != texture->renderer) {
         return SDL_SetError("Texture was not created with this renderer");
     }
+    CommitTextureUploadsIfPending(texture);
     if (!renderer->QueueCopyEx && !renderer->QueueGeometry) {
         return SDL_SetError("Renderer does not support RenderCopyEx");
     }
@@ -4095,6 +5365,7 @@ int SDL_RenderGeometryRaw(SDL_Renderer *renderer,
         if (renderer != texture->renderer) {
             return SDL_SetError("Texture was not created with this renderer");
         }
+        CommitTextureUploadsIfPending(texture);
     }
 
     if (!xy) {
@@ -4258,8 +5529,17 @@ void SDL_RenderPresent(SDL_Renderer *renderer)
 
     CHECK_RENDERER_MAGIC(renderer, );
 
+    /* Commit what the workers converted since the last frame */
+    CommitTextureUploads(renderer, NULL, SDL_FALSE, renderer->upload_budget);
+    renderer->stats.uploads_pending = (Uint32)CountTextureUploads(renderer);
+
     FlushRenderCommands(renderer); /* time to send everything to the GPU! */
 
+    renderer->stats.arena_bytes = (Uint32)(renderer->render_commands_allocated * sizeof(SDL_RenderCommand) +
+                                           renderer->vertex_data_allocation + renderer->scratch_allocation);
+    SDL_copyp(&renderer->last_stats, &renderer->stats);
+    SDL_zero(renderer->stats);
+
 #if DONT_DRAW_WHILE_HIDDEN
     /* Don't present while we're hidden */
     if (renderer->hidden) {
@@ -4270,12 +5550,27 @@ void SDL_RenderPresent(SDL_Renderer *renderer)
         presented = SDL_FALSE;
     }
 
+    if (presented) {
+        SDL_zero(renderer->damage);
+    }
+
     if (renderer->simulate_vsync ||
         (!presented && renderer->wanted_vsync)) {
         SDL_RenderSimulateVSync(renderer);
     }
 }
 
+int SDL_GetRenderStats(SDL_Renderer *renderer, SDL_RenderStats *stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    SDL_copyp(stats, &renderer->last_stats);
+    return 0;
+}
+
 void SDL_DestroyTexture(SDL_Texture *texture)
 {
     SDL_Renderer *renderer;
@@ -4289,6 +5584,8 @@ void SDL_DestroyTexture(SDL_Texture *texture)
         FlushRenderCommandsIfTextureNeeded(texture);
     }
 
+    CancelTextureUploads(texture);
+
     texture->magic = NULL;
 
     if (texture->next) {
@@ -4320,30 +5617,30 @@ void SDL_DestroyTexture(SDL_Texture *texture)
 
 void SDL_DestroyRenderer(SDL_Renderer *renderer)
 {
-    SDL_RenderCommand *cmd;
+    SDL_RenderCommandBlock *block;
 
     CHECK_RENDERER_MAGIC(renderer, );
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
-    if (renderer->render_commands_tail) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        cmd = renderer->render_commands;
-    } else {
-        cmd = renderer->render_commands_pool;
-    }
+    DestroyUploadQueue(renderer->uploads);
+    renderer->uploads = NULL;
 
     renderer->render_commands_pool = NULL;
     renderer->render_commands_tail = NULL;
     renderer->render_commands = NULL;
 
-    while (cmd) {
-        SDL_RenderCommand *next = cmd->next;
-        SDL_free(cmd);
-        cmd = next;
+    block = renderer->render_command_blocks;
+    while (block) {
+        SDL_RenderCommandBlock *next = block->next;
+        SDL_free(block);
+        block = next;
     }
+    renderer->render_command_blocks = NULL;
+    renderer->render_commands_allocated = 0;
 
     SDL_free(renderer->vertex_data);
+    SDL_free(renderer->scratch);
 
     /* Free existing textures for this renderer */
     while (renderer->textures) {
@@ -4374,6 +5671,7 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
 
     CHECK_TEXTURE_MAGIC(texture, -1);
     renderer = texture->renderer;
+    CommitTextureUploadsIfPending(texture);
     if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
     } else if (renderer && renderer->GL_BindTexture) {
@@ -73,6 +73,11 @@ struct SDL_Texture
 
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
 
+    SDL_bool track_damage; /**< Whether draws into this render target are tracked */
+    SDL_Rect damage;       /**< Area changed since the damage was last read, empty if none */
+
+    int pending_uploads; /**< Queued updates not committed to this texture yet */
+
     void *driverdata; /**< Driver specific texture representation */
     void *userdata;
 
@@ -171,6 +176,9 @@ struct SDL_Renderer
     int (*UpdateTexture)(SDL_Renderer *renderer, SDL_Texture *texture,
                          const SDL_Rect *rect, const void *pixels,
                          int pitch);
+    /* Optional: makes a new static texture use the pixels of a surface in its
+       format instead of a copy, see SDL_HINT_RENDER_SHARE_SURFACE_PIXELS */
+    int (*ShareTexturePixels)(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Surface *surface);
 #if SDL_HAVE_YUV
     int (*UpdateTextureYUV)(SDL_Renderer *renderer, SDL_Texture *texture,
                             const SDL_Rect *rect,
@@ -261,14 +269,34 @@ struct SDL_Renderer
     SDL_Texture *target;
     SDL_mutex *target_mutex;
 
+    /* Area of the default target drawn since the last present, tracked for
+       backends that set track_damage to present only what changed */
+    SDL_bool track_damage;
+    SDL_Rect damage;
+
+    /* Texture updates converted by worker threads, created on first use */
+    struct SDL_UploadQueue *uploads;
+    size_t upload_budget;
+
     SDL_Color color;         /**< Color for drawing operations values */
     SDL_BlendMode blendMode; /**< The drawing blend mode */
 
     SDL_bool always_batch;
     SDL_bool batching;
+
+    /* The backend reads draw colors from the draw commands, so no
+       SDL_RENDERCMD_SETDRAWCOLOR is queued ahead of them */
+    SDL_bool draw_color_in_commands;
+
+    /* The backend bakes draw colors into the vertex data at queue time, so
+       draws that only differ in color can share one command */
+    SDL_bool draw_color_in_vertices;
+
     SDL_RenderCommand *render_commands;
     SDL_RenderCommand *render_commands_tail;
     SDL_RenderCommand *render_commands_pool;
+    struct SDL_RenderCommandBlock *render_command_blocks; /* where the commands are allocated */
+    size_t render_commands_allocated;
     Uint32 render_command_generation;
     Uint32 last_queued_color;
     SDL_DRect last_queued_viewport;
@@ -282,6 +310,16 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* Temporaries used while queueing commands, resized between frames to
+       the most any frame has needed */
+    void *scratch;
+    size_t scratch_used;
+    size_t scratch_allocation;
+    size_t scratch_high_water;
+
+    SDL_RenderStats stats;      /**< Counters of the frame being queued */
+    SDL_RenderStats last_stats; /**< Counters of the last presented frame */
+
     void *driverdata;
 };
 
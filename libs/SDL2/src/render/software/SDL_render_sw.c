@@ -25,6 +25,8 @@
 #include "../SDL_sysrender.h"
 #include "SDL_render_sw_c.h"
 #include "SDL_hints.h"
+#include "SDL_cpuinfo.h"
+#include "../../thread/SDL_systhread.h"
 
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
@@ -48,6 +50,8 @@ typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    struct SW_TileQueue *tiles; /* NULL unless SDL_HINT_RENDER_SOFTWARE_THREADS asks for threads */
+    SDL_bool present_all;       /* the window needs all of the surface, not just the damage */
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -73,6 +77,9 @@ static void SW_WindowEvent(SDL_Renderer *renderer, const SDL_WindowEvent *event)
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+        data->present_all = SDL_TRUE;
+    } else if (event->event == SDL_WINDOWEVENT_EXPOSED) {
+        data->present_all = SDL_TRUE;
     }
 }
 
@@ -127,6 +134,58 @@ static int SW_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     return 0;
 }
 
+/* Wraps the pixels of 'source' in the texture surface. The wrapper holds a
+   reference to 'source' in its userdata until the texture is updated or
+   destroyed. */
+static int SW_ShareTexturePixels(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Surface *source)
+{
+    SDL_Surface *surface;
+
+    surface = SDL_CreateRGBSurfaceWithFormatFrom(source->pixels, texture->w, texture->h,
+                                                 source->format->BitsPerPixel, source->pitch,
+                                                 texture->format);
+    if (!surface) {
+        return -1;
+    }
+    SDL_SetSurfaceColorMod(surface, texture->color.r, texture->color.g, texture->color.b);
+    SDL_SetSurfaceAlphaMod(surface, texture->color.a);
+    SDL_SetSurfaceBlendMode(surface, texture->blendMode);
+
+    surface->userdata = source;
+    ++source->refcount;
+
+    SDL_FreeSurface((SDL_Surface *)texture->driverdata);
+    texture->driverdata = surface;
+    return 0;
+}
+
+static void SW_FreeTextureSurface(SDL_Surface *surface)
+{
+    if (surface) {
+        SDL_Surface *source = (SDL_Surface *)surface->userdata;
+
+        SDL_FreeSurface(surface);
+        SDL_FreeSurface(source);
+    }
+}
+
+/* Gives a texture sharing the pixels of a surface its own copy of them */
+static int SW_UnshareTexture(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_Surface *shared = (SDL_Surface *)texture->driverdata;
+    SDL_Surface *surface;
+
+    if (SW_CreateTexture(renderer, texture) < 0) {
+        texture->driverdata = shared;
+        return -1;
+    }
+    surface = (SDL_Surface *)texture->driverdata;
+    SDL_ConvertPixels(texture->w, texture->h, texture->format, shared->pixels, shared->pitch,
+                      texture->format, surface->pixels, surface->pitch);
+    SW_FreeTextureSurface(shared);
+    return 0;
+}
+
 static int SW_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
                             const SDL_Rect *rect, const void *pixels, int pitch)
 {
@@ -135,6 +194,12 @@ static int SW_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
     int row;
     size_t length;
 
+    if (surface->userdata) {
+        if (SW_UnshareTexture(renderer, texture) < 0) {
+            return -1;
+        }
+        surface = (SDL_Surface *)texture->driverdata;
+    }
     if (SDL_MUSTLOCK(surface)) {
         SDL_LockSurface(surface);
     }
@@ -613,29 +678,66 @@ static int SW_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     return 0;
 }
 
-static void PrepTextureForCopy(const SDL_RenderCommand *cmd)
+static void PrepTextureColorForCopy(const SDL_RenderCommand *cmd)
 {
     const Uint8 r = cmd->data.draw.r;
     const Uint8 g = cmd->data.draw.g;
     const Uint8 b = cmd->data.draw.b;
     const Uint8 a = cmd->data.draw.a;
-    const SDL_BlendMode blend = cmd->data.draw.blend;
     SDL_Texture *texture = cmd->data.draw.texture;
     SDL_Surface *surface = (SDL_Surface *)texture->driverdata;
     const SDL_bool colormod = ((r & g & b) != 0xFF);
     const SDL_bool alphamod = (a != 0xFF);
-    const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
 
-    if (colormod || alphamod || blending) {
+    if (colormod || alphamod) {
         SDL_SetSurfaceRLE(surface, 0);
     }
 
-    /* !!! FIXME: we can probably avoid some of these calls. */
     SDL_SetSurfaceColorMod(surface, r, g, b);
     SDL_SetSurfaceAlphaMod(surface, a);
+}
+
+static void PrepTextureForCopy(const SDL_RenderCommand *cmd)
+{
+    const SDL_BlendMode blend = cmd->data.draw.blend;
+    SDL_Texture *texture = cmd->data.draw.texture;
+    SDL_Surface *surface = (SDL_Surface *)texture->driverdata;
+    const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
+
+    if (blending) {
+        SDL_SetSurfaceRLE(surface, 0);
+    }
+
+    PrepTextureColorForCopy(cmd);
     SDL_SetSurfaceBlendMode(surface, blend);
 }
 
+/* Whether a copy can reuse the texture state set up for the copy before it,
+ * apart from the color and alpha mod. */
+static SDL_bool SW_SameCopyState(const SDL_RenderCommand *cmd, const SDL_RenderCommand *next)
+{
+    return next && next->command == SDL_RENDERCMD_COPY &&
+           next->data.draw.texture == cmd->data.draw.texture &&
+           next->data.draw.blend == cmd->data.draw.blend;
+}
+
+static SDL_bool SW_SameColor(const SDL_RenderCommand *cmd, const SDL_RenderCommand *next)
+{
+    return next->data.draw.r == cmd->data.draw.r && next->data.draw.g == cmd->data.draw.g &&
+           next->data.draw.b == cmd->data.draw.b && next->data.draw.a == cmd->data.draw.a;
+}
+
+/* Whether the rects of a FILL_RECTS can be filled in the same call as those
+ * of the one before it: same color and blend mode, and the rects follow each
+ * other in the vertex buffer. */
+static SDL_bool SW_SameFill(const SDL_RenderCommand *cmd, const SDL_RenderCommand *next)
+{
+    return next && next->command == SDL_RENDERCMD_FILL_RECTS &&
+           next->data.draw.first == cmd->data.draw.first + cmd->data.draw.count * sizeof(SDL_Rect) &&
+           next->data.draw.blend == cmd->data.draw.blend &&
+           SW_SameColor(cmd, next);
+}
+
 static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
 {
     if (drawstate->surface_cliprect_dirty) {
@@ -658,9 +760,870 @@ static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
     }
 }
 
+/* Same size copies of a color modulated, alpha blended ARGB8888 texture,
+ * glyphs mostly, are drawn by these instead of the generic blitters. They
+ * give the exact same pixels as SDL_Blit_ARGB8888_*_Modulate_Blend(),
+ * which SDL_BlitSurface() would pick for them.
+ */
+#if defined(__SSE2__)
+#define HAVE_SSE2_INTRINSICS
+#endif
+
+#if defined(__ARM_NEON)
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+/* Blends a row of 'width' modulated source pixels onto the destination.
+ * 'mod' is the r, g, b, a modulation, 'alpha_mask' 0 for a destination without
+ * alpha, whose alpha byte is zeroed like the generic blitter does. */
+typedef void (*SW_BlendCopyFunc)(Uint32 *dst, const Uint32 *src, int width, const Uint8 *mod, Uint32 alpha_mask);
+
+static void SW_BlendCopyRow(Uint32 *dst, const Uint32 *src, int width, const Uint8 *mod, Uint32 alpha_mask)
+{
+    const Uint32 modR = mod[0], modG = mod[1], modB = mod[2], modA = mod[3];
+    int i;
+
+    for (i = 0; i < width; i++) {
+        const Uint32 srcpixel = src[i];
+        const Uint32 dstpixel = dst[i];
+        const Uint32 srcA = ((srcpixel >> 24) * modA) / 255;
+        const Uint32 srcR = ((((Uint8)(srcpixel >> 16) * modR) / 255) * srcA) / 255;
+        const Uint32 srcG = ((((Uint8)(srcpixel >> 8) * modG) / 255) * srcA) / 255;
+        const Uint32 srcB = ((((Uint8)srcpixel * modB) / 255) * srcA) / 255;
+        const Uint32 dstA = srcA + ((255 - srcA) * (dstpixel >> 24)) / 255;
+        const Uint32 dstR = srcR + ((255 - srcA) * (Uint8)(dstpixel >> 16)) / 255;
+        const Uint32 dstG = srcG + ((255 - srcA) * (Uint8)(dstpixel >> 8)) / 255;
+        const Uint32 dstB = srcB + ((255 - srcA) * (Uint8)dstpixel) / 255;
+
+        dst[i] = ((dstA << 24) & alpha_mask) | (dstR << 16) | (dstG << 8) | dstB;
+    }
+}
+
+#if defined(HAVE_SSE2_INTRINSICS)
+static SDL_INLINE int hasSSE2(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasSSE2();
+    return val;
+}
+
+/* x / 255, exact for the products of two bytes */
+static SDL_INLINE __m128i SW_Div255_SSE2(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+/* Two pixels, one 16-bit lane per channel */
+static SDL_INLINE __m128i SW_BlendCopy_SSE2(__m128i s, __m128i d, __m128i mod, __m128i alpha_one)
+{
+    __m128i a;
+
+    s = SW_Div255_SSE2(_mm_mullo_epi16(s, mod));
+    a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    /* Premultiply color, the alpha lane is multiplied by 255 and stays */
+    s = SW_Div255_SSE2(_mm_mullo_epi16(s, _mm_or_si128(a, alpha_one)));
+    d = SW_Div255_SSE2(_mm_mullo_epi16(d, _mm_sub_epi16(_mm_set1_epi16(255), a)));
+    return _mm_add_epi16(s, d);
+}
+
+static void SW_BlendCopyRow_SSE2(Uint32 *dst, const Uint32 *src, int width, const Uint8 *mod, Uint32 alpha_mask)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mods = _mm_set_epi16(mod[3], mod[0], mod[1], mod[2], mod[3], mod[0], mod[1], mod[2]);
+    const __m128i alpha_one = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i mask = _mm_set1_epi32((int)(alpha_mask | 0x00FFFFFF));
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        const __m128i lo = SW_BlendCopy_SSE2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), mods, alpha_one);
+        const __m128i hi = SW_BlendCopy_SSE2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), mods, alpha_one);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_and_si128(_mm_packus_epi16(lo, hi), mask));
+    }
+    SW_BlendCopyRow(dst + i, src + i, width - i, mod, alpha_mask);
+}
+#endif
+
+#if defined(HAVE_NEON_INTRINSICS)
+static SDL_INLINE int hasNEON(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasNEON();
+    return val;
+}
+
+/* x / 255, exact for the products of two bytes */
+static SDL_INLINE uint16x8_t SW_Div255_NEON(uint16x8_t x)
+{
+    return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+/* Eight pixels of one channel */
+static SDL_INLINE uint8x8_t SW_BlendCopy_NEON(uint8x8_t s, uint8x8_t d, uint8x8_t mod, uint16x8_t a, uint16x8_t inv_a)
+{
+    const uint16x8_t color = SW_Div255_NEON(vmulq_u16(SW_Div255_NEON(vmull_u8(s, mod)), a));
+    return vmovn_u16(vaddq_u16(color, SW_Div255_NEON(vmulq_u16(vmovl_u8(d), inv_a))));
+}
+
+static void SW_BlendCopyRow_NEON(Uint32 *dst, const Uint32 *src, int width, const Uint8 *mod, Uint32 alpha_mask)
+{
+    const uint8x8_t modR = vdup_n_u8(mod[0]);
+    const uint8x8_t modG = vdup_n_u8(mod[1]);
+    const uint8x8_t modB = vdup_n_u8(mod[2]);
+    const uint8x8_t modA = vdup_n_u8(mod[3]);
+    const uint8x8_t keep_alpha = vdup_n_u8(alpha_mask ? 0xFF : 0x00);
+    int i;
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        /* val[0..3] are the B, G, R, A planes of ARGB8888 in memory */
+        const uint8x8x4_t s = vld4_u8((const uint8_t *)(src + i));
+        uint8x8x4_t d = vld4_u8((const uint8_t *)(dst + i));
+        const uint16x8_t a = SW_Div255_NEON(vmull_u8(s.val[3], modA));
+        const uint16x8_t inv_a = vsubq_u16(vdupq_n_u16(255), a);
+
+        d.val[0] = SW_BlendCopy_NEON(s.val[0], d.val[0], modB, a, inv_a);
+        d.val[1] = SW_BlendCopy_NEON(s.val[1], d.val[1], modG, a, inv_a);
+        d.val[2] = SW_BlendCopy_NEON(s.val[2], d.val[2], modR, a, inv_a);
+        d.val[3] = vand_u8(vmovn_u16(vaddq_u16(a, SW_Div255_NEON(vmulq_u16(vmovl_u8(d.val[3]), inv_a)))), keep_alpha);
+        vst4_u8((uint8_t *)(dst + i), d);
+    }
+    SW_BlendCopyRow(dst + i, src + i, width - i, mod, alpha_mask);
+}
+#endif
+
+/* Without a color mod SDL_BlitSurface() uses the SDL_blit_A.c blitters,
+ * which round differently, so those copies are left to it. */
+static SDL_bool SW_IsColorModulated(const SDL_RenderCommand *cmd)
+{
+    return (cmd->data.draw.r & cmd->data.draw.g & cmd->data.draw.b) != 0xFF;
+}
+
+/* Picks the row blender for a run of copies with the texture and blend mode
+ * of 'cmd', NULL if they have to go through SDL_BlitSurface(). */
+static SW_BlendCopyFunc SW_GetBlendCopyFunc(SDL_Surface *surface, const SDL_RenderCommand *cmd)
+{
+    SDL_Surface *src = (SDL_Surface *) cmd->data.draw.texture->driverdata;
+
+    if (cmd->data.draw.blend != SDL_BLENDMODE_BLEND) {
+        return NULL;
+    }
+    if (src->format->format != SDL_PIXELFORMAT_ARGB8888 ||
+        (surface->format->format != SDL_PIXELFORMAT_ARGB8888 && surface->format->format != SDL_PIXELFORMAT_XRGB8888)) {
+        return NULL;
+    }
+    if (SDL_HasSurfaceRLE(src) || SDL_HasColorKey(src) || SDL_MUSTLOCK(src) || SDL_MUSTLOCK(surface)) {
+        return NULL;
+    }
+
+#if defined(HAVE_NEON_INTRINSICS)
+    if (hasNEON()) {
+        return SW_BlendCopyRow_NEON;
+    }
+#endif
+#if defined(HAVE_SSE2_INTRINSICS)
+    if (hasSSE2()) {
+        return SW_BlendCopyRow_SSE2;
+    }
+#endif
+    return SW_BlendCopyRow;
+}
+
+/* A same size copy, clipped like SDL_BlitSurface() does */
+static void SW_BlendCopy(SW_BlendCopyFunc blend, SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *surface, const SDL_Rect *dstrect,
+                         const SDL_RenderCommand *cmd)
+{
+    const Uint32 alpha_mask = (surface->format->format == SDL_PIXELFORMAT_ARGB8888) ? 0xFF000000 : 0;
+    SDL_Rect src_bounds, unclipped, r_src, r_dst;
+    const Uint8 *srcpixels;
+    Uint8 *dstpixels;
+    Uint8 mod[4];
+    int y;
+
+    src_bounds.x = 0;
+    src_bounds.y = 0;
+    src_bounds.w = src->w;
+    src_bounds.h = src->h;
+    if (!SDL_IntersectRect(srcrect, &src_bounds, &r_src)) {
+        return;
+    }
+    unclipped.x = dstrect->x + r_src.x - srcrect->x;
+    unclipped.y = dstrect->y + r_src.y - srcrect->y;
+    unclipped.w = r_src.w;
+    unclipped.h = r_src.h;
+    if (!SDL_IntersectRect(&unclipped, &surface->clip_rect, &r_dst)) {
+        return;
+    }
+    r_src.x += r_dst.x - unclipped.x;
+    r_src.y += r_dst.y - unclipped.y;
+
+    mod[0] = cmd->data.draw.r;
+    mod[1] = cmd->data.draw.g;
+    mod[2] = cmd->data.draw.b;
+    mod[3] = cmd->data.draw.a;
+    srcpixels = (const Uint8 *) src->pixels + r_src.y * src->pitch + r_src.x * 4;
+    dstpixels = (Uint8 *) surface->pixels + r_dst.y * surface->pitch + r_dst.x * 4;
+    for (y = 0; y < r_dst.h; y++) {
+        blend((Uint32 *) dstpixels, (const Uint32 *) srcpixels, r_dst.w, mod, alpha_mask);
+        srcpixels += src->pitch;
+        dstpixels += surface->pitch;
+    }
+}
+
+/* Merged copies hold one srcrect/dstrect pair per copy, 'blend' draws the
+ * same size ones if not NULL */
+static void SW_CopyRects(SDL_Surface *surface, const SDL_RenderCommand *cmd, const SW_DrawStateCache *drawstate, SDL_Rect *verts, const size_t count,
+                         SW_BlendCopyFunc blend)
+{
+    SDL_Texture *texture = cmd->data.draw.texture;
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+    size_t i;
+
+    for (i = 0; i < count; i++, verts += 2) {
+        const SDL_Rect *srcrect = verts;
+        SDL_Rect *dstrect = verts + 1;
+
+        /* Apply viewport */
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            dstrect->x += drawstate->viewport->x;
+            dstrect->y += drawstate->viewport->y;
+        }
+
+        if (srcrect->w == dstrect->w && srcrect->h == dstrect->h && blend) {
+            SW_BlendCopy(blend, src, srcrect, surface, dstrect, cmd);
+        } else if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
+            SDL_BlitSurface(src, srcrect, surface, dstrect);
+        } else {
+            /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+             * to avoid potentially frequent RLE encoding/decoding.
+             */
+            SDL_SetSurfaceRLE(surface, 0);
+
+            /* Prevent to do scaling + clipping on viewport boundaries as it may lose proportion */
+            if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
+                SDL_Surface *tmp = SDL_CreateRGBSurfaceWithFormat(0, dstrect->w, dstrect->h, 0, src->format->format);
+                /* Scale to an intermediate surface, then blit */
+                if (tmp) {
+                    SDL_Rect r;
+                    SDL_BlendMode blendmode;
+                    Uint8 alphaMod, rMod, gMod, bMod;
+
+                    SDL_GetSurfaceBlendMode(src, &blendmode);
+                    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+                    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+
+                    r.x = 0;
+                    r.y = 0;
+                    r.w = dstrect->w;
+                    r.h = dstrect->h;
+
+                    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+                    SDL_SetSurfaceColorMod(src, 255, 255, 255);
+                    SDL_SetSurfaceAlphaMod(src, 255);
+
+                    SDL_PrivateUpperBlitScaled(src, srcrect, tmp, &r, texture->scaleMode);
+
+                    SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
+                    SDL_SetSurfaceAlphaMod(tmp, alphaMod);
+                    SDL_SetSurfaceBlendMode(tmp, blendmode);
+
+                    SDL_BlitSurface(tmp, NULL, surface, dstrect);
+                    SDL_FreeSurface(tmp);
+
+                    /* The next copy blits from 'src' with the same state */
+                    SDL_SetSurfaceColorMod(src, rMod, gMod, bMod);
+                    SDL_SetSurfaceAlphaMod(src, alphaMod);
+                    SDL_SetSurfaceBlendMode(src, blendmode);
+                }
+            } else{
+                SDL_PrivateUpperBlitScaled(src, srcrect, surface, dstrect, texture->scaleMode);
+            }
+        }
+    }
+}
+
+/* Binned rendering: the target is split into tiles, the commands that give
+ * the same pixels when clipped to a tile are binned by bounding box, and the
+ * tiles are rasterized by a pool of threads. Every other command is run
+ * serially once the binned commands queued before it have been drawn.
+ */
+#define SW_TILE_SHIFT          6 /* 64x64 pixel tiles */
+#define SW_TILE_SIZE           (1 << SW_TILE_SHIFT)
+#define SW_TILE_ALL            0xFFFFFFFF
+#define SW_TILE_MIN_PRIMITIVES 16 /* fewer aren't worth binning and waking the workers for */
+
+typedef struct
+{
+    const SDL_RenderCommand *cmd;
+    void *verts;
+    SDL_Rect clip;
+    int source;             /* index into SW_TileQueue::sources for copies */
+    SW_BlendCopyFunc blend; /* for copies that don't need SDL_BlitSurface() */
+} SW_TileCommand;
+
+typedef struct
+{
+    Uint32 command; /* index into SW_TileQueue::commands */
+    Uint32 index;   /* rect or copy within the command, SW_TILE_ALL for all of it */
+    SDL_Rect bounds;
+} SW_TilePrimitive;
+
+typedef struct SW_TileQueue SW_TileQueue;
+
+typedef struct
+{
+    SW_TileQueue *queue;
+    SDL_Thread *thread;
+    SDL_Surface *target;   /* view of the render target, NULL if not taking part */
+    SDL_Surface **sources; /* views of the textures copied from */
+    int max_sources;
+} SW_TileWorker;
+
+struct SW_TileQueue
+{
+    int num_workers; /* including the rendering thread, which is worker 0 */
+    SW_TileWorker *workers;
+    SDL_mutex *lock;
+    SDL_cond *work_cond;
+    SDL_cond *done_cond;
+    Uint32 generation;
+    int busy;
+    SDL_bool quit;
+
+    int tiles_x;
+    int num_tiles;
+    SDL_atomic_t next_tile;
+
+    SW_TileCommand *commands;
+    int num_commands, max_commands;
+    SW_TilePrimitive *primitives;
+    int num_primitives, max_primitives;
+    SDL_Surface **sources;
+    int num_sources, max_sources;
+    Uint32 *bins; /* primitive indices, grouped by tile in queue order */
+    int max_bins;
+    int *bin_start; /* where each tile's primitives start in bins, plus the end */
+    int max_tiles;
+};
+
+static SDL_bool SW_GrowArray(void **array, int *max, int needed, size_t size)
+{
+    if (needed > *max) {
+        const int new_max = SDL_max(needed, *max * 2);
+        void *ptr = SDL_realloc(*array, new_max * size);
+        if (!ptr) {
+            return SDL_FALSE;
+        }
+        *array = ptr;
+        *max = new_max;
+    }
+    return SDL_TRUE;
+}
+
+static void SW_DrawTilePrimitive(SW_TileQueue *queue, SW_TileWorker *worker, const SDL_Rect *area, Uint32 index, int *last)
+{
+    const SW_TilePrimitive *prim = &queue->primitives[index];
+    const SW_TileCommand *tc = &queue->commands[prim->command];
+    const SDL_RenderCommand *cmd = tc->cmd;
+    SDL_Surface *target = worker->target;
+    SDL_Rect clip;
+
+    if (!SDL_IntersectRect(&tc->clip, area, &clip)) {
+        return;
+    }
+    SDL_SetClipRect(target, &clip);
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR: {
+            const Uint8 r = cmd->data.color.r;
+            const Uint8 g = cmd->data.color.g;
+            const Uint8 b = cmd->data.color.b;
+            const Uint8 a = cmd->data.color.a;
+            SDL_FillRect(target, &clip, SDL_MapRGBA(target->format, r, g, b, a));
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_POINTS: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Point *verts = (const SDL_Point *) tc->verts;
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawPoints(target, verts, count, SDL_MapRGBA(target->format, r, g, b, a));
+            } else {
+                SDL_BlendPoints(target, verts, count, blend, r, g, b, a);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const SDL_Rect *rect = (const SDL_Rect *) tc->verts + prim->index;
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_FillRect(target, rect, SDL_MapRGBA(target->format, r, g, b, a));
+            } else {
+                SDL_BlendFillRect(target, rect, blend, r, g, b, a);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            const SDL_Rect *verts = (const SDL_Rect *) tc->verts + prim->index * 2;
+            SDL_Surface *src = worker->sources[tc->source];
+            SDL_Rect dstrect = verts[1];
+
+            if (tc->blend) {
+                SW_BlendCopy(tc->blend, src, &verts[0], target, &dstrect, cmd);
+                break;
+            }
+            if (*last != (int) prim->command) {
+                SDL_SetSurfaceColorMod(src, cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b);
+                SDL_SetSurfaceAlphaMod(src, cmd->data.draw.a);
+                SDL_SetSurfaceBlendMode(src, cmd->data.draw.blend);
+                *last = (int) prim->command;
+            }
+            SDL_BlitSurface(src, &verts[0], target, &dstrect);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static void SW_RenderTiles(SW_TileQueue *queue, SW_TileWorker *worker)
+{
+    for (;;) {
+        const int tile = SDL_AtomicAdd(&queue->next_tile, 1);
+        SDL_Rect area;
+        int last = -1;
+        int i;
+
+        if (tile >= queue->num_tiles) {
+            break;
+        }
+
+        area.x = (tile % queue->tiles_x) << SW_TILE_SHIFT;
+        area.y = (tile / queue->tiles_x) << SW_TILE_SHIFT;
+        area.w = SDL_min(SW_TILE_SIZE, worker->target->w - area.x);
+        area.h = SDL_min(SW_TILE_SIZE, worker->target->h - area.y);
+
+        for (i = queue->bin_start[tile]; i < queue->bin_start[tile + 1]; i++) {
+            SW_DrawTilePrimitive(queue, worker, &area, queue->bins[i], &last);
+        }
+    }
+}
+
+static int SDLCALL SW_TileThread(void *data)
+{
+    SW_TileWorker *worker = (SW_TileWorker *) data;
+    SW_TileQueue *queue = worker->queue;
+    Uint32 generation = 0;
+
+    SDL_LockMutex(queue->lock);
+    for (;;) {
+        while (!queue->quit && queue->generation == generation) {
+            SDL_CondWait(queue->work_cond, queue->lock);
+        }
+        if (queue->quit) {
+            break;
+        }
+        generation = queue->generation;
+
+        if (worker->target) {
+            SDL_UnlockMutex(queue->lock);
+            SW_RenderTiles(queue, worker);
+            SDL_LockMutex(queue->lock);
+        }
+        if (--queue->busy == 0) {
+            SDL_CondSignal(queue->done_cond);
+        }
+    }
+    SDL_UnlockMutex(queue->lock);
+    return 0;
+}
+
+static void SW_DestroyTileQueue(SW_TileQueue *queue)
+{
+    int i;
+
+    if (!queue) {
+        return;
+    }
+
+    if (queue->lock) {
+        SDL_LockMutex(queue->lock);
+        queue->quit = SDL_TRUE;
+        SDL_CondBroadcast(queue->work_cond);
+        SDL_UnlockMutex(queue->lock);
+    }
+    if (queue->workers) {
+        for (i = 1; i < queue->num_workers; i++) {
+            SDL_WaitThread(queue->workers[i].thread, NULL);
+            SDL_free(queue->workers[i].sources);
+        }
+        SDL_free(queue->workers);
+    }
+    SDL_DestroyCond(queue->done_cond);
+    SDL_DestroyCond(queue->work_cond);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue->commands);
+    SDL_free(queue->primitives);
+    SDL_free(queue->sources);
+    SDL_free(queue->bins);
+    SDL_free(queue->bin_start);
+    SDL_free(queue);
+}
+
+static SW_TileQueue *SW_CreateTileQueue(int num_threads)
+{
+    SW_TileQueue *queue;
+    int i;
+
+    queue = (SW_TileQueue *) SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+    queue->workers = (SW_TileWorker *) SDL_calloc(num_threads, sizeof(*queue->workers));
+    queue->lock = SDL_CreateMutex();
+    queue->work_cond = SDL_CreateCond();
+    queue->done_cond = SDL_CreateCond();
+    if (!queue->workers || !queue->lock || !queue->work_cond || !queue->done_cond) {
+        SW_DestroyTileQueue(queue);
+        return NULL;
+    }
+
+    queue->workers[0].queue = queue;
+    queue->num_workers = 1;
+    for (i = 1; i < num_threads; i++) {
+        SW_TileWorker *worker = &queue->workers[i];
+        worker->queue = queue;
+        worker->thread = SDL_CreateThreadInternal(SW_TileThread, "SDLSWTile", 0, worker);
+        if (!worker->thread) {
+            break;
+        }
+        queue->num_workers++;
+    }
+    if (queue->num_workers < 2) {
+        SW_DestroyTileQueue(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+/* Queues the part of the last binned command covering 'bounds' */
+static void SW_AddTilePrimitive(SW_TileQueue *queue, Uint32 index, const SDL_Rect *bounds)
+{
+    const SW_TileCommand *tc = &queue->commands[queue->num_commands - 1];
+    SW_TilePrimitive *prim = &queue->primitives[queue->num_primitives];
+
+    if (SDL_IntersectRect(bounds, &tc->clip, &prim->bounds)) {
+        prim->command = queue->num_commands - 1;
+        prim->index = index;
+        queue->num_primitives++;
+    }
+}
+
+/* Whether a copy is a plain blit, which gives the same pixels clipped to a tile */
+static SDL_bool SW_CanBinCopy(const SDL_RenderCommand *cmd, const SDL_Rect *verts)
+{
+    SDL_Surface *src = (SDL_Surface *) cmd->data.draw.texture->driverdata;
+    size_t i;
+
+    if (SDL_HasSurfaceRLE(src) || SDL_HasColorKey(src) || src->format->palette) {
+        return SDL_FALSE;
+    }
+    for (i = 0; i < cmd->data.draw.count; i++, verts += 2) {
+        if (verts[0].w != verts[1].w || verts[0].h != verts[1].h) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Bins a command if it can be drawn a tile at a time, returns SDL_FALSE if it
+ * has to be run serially. */
+static SDL_bool SW_BinCommand(SW_TileQueue *queue, SDL_Surface *surface, const SDL_RenderCommand *cmd, void *vertices, SW_DrawStateCache *drawstate)
+{
+    void *verts = ((Uint8 *) vertices) + cmd->data.draw.first;
+    size_t count = 1;
+    SW_TileCommand *tc;
+    int source = -1;
+    size_t i;
+
+    if (surface->format->palette || SDL_MUSTLOCK(surface)) {
+        return SDL_FALSE;
+    }
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR:
+            verts = NULL;
+            break;
+        case SDL_RENDERCMD_DRAW_POINTS:
+            break;
+        case SDL_RENDERCMD_FILL_RECTS:
+            count = cmd->data.draw.count;
+            break;
+        case SDL_RENDERCMD_COPY:
+            if (!SW_CanBinCopy(cmd, (const SDL_Rect *) verts)) {
+                return SDL_FALSE;
+            }
+            count = cmd->data.draw.count;
+            break;
+        default:
+            return SDL_FALSE;
+    }
+
+    if (!SW_GrowArray((void **) &queue->commands, &queue->max_commands, queue->num_commands + 1, sizeof(*queue->commands)) ||
+        !SW_GrowArray((void **) &queue->primitives, &queue->max_primitives, queue->num_primitives + (int) count, sizeof(*queue->primitives))) {
+        return SDL_FALSE;
+    }
+    if (cmd->command == SDL_RENDERCMD_COPY) {
+        SDL_Surface *src = (SDL_Surface *) cmd->data.draw.texture->driverdata;
+        for (source = 0; source < queue->num_sources; source++) {
+            if (queue->sources[source] == src) {
+                break;
+            }
+        }
+        if (source == queue->num_sources) {
+            if (!SW_GrowArray((void **) &queue->sources, &queue->max_sources, queue->num_sources + 1, sizeof(*queue->sources))) {
+                return SDL_FALSE;
+            }
+            queue->sources[queue->num_sources++] = src;
+        }
+    }
+
+    tc = &queue->commands[queue->num_commands++];
+    tc->cmd = cmd;
+    tc->verts = verts;
+    tc->source = source;
+    tc->blend = NULL;
+    if (cmd->command == SDL_RENDERCMD_COPY && SW_IsColorModulated(cmd)) {
+        tc->blend = SW_GetBlendCopyFunc(surface, cmd);
+    }
+
+    if (cmd->command == SDL_RENDERCMD_CLEAR) {
+        /* By definition the clear ignores the clip rect */
+        tc->clip.x = 0;
+        tc->clip.y = 0;
+        tc->clip.w = surface->w;
+        tc->clip.h = surface->h;
+        SW_AddTilePrimitive(queue, SW_TILE_ALL, &tc->clip);
+        return SDL_TRUE;
+    }
+
+    /* This leaves the same clip rect on the surface as running the command would */
+    SetDrawState(surface, drawstate);
+    tc->clip = surface->clip_rect;
+
+    if (cmd->command == SDL_RENDERCMD_DRAW_POINTS) {
+        SDL_Point *points = (SDL_Point *) verts;
+        SDL_Rect bounds;
+
+        count = cmd->data.draw.count;
+        for (i = 0; i < count; i++) {
+            points[i].x += drawstate->viewport->x;
+            points[i].y += drawstate->viewport->y;
+        }
+        if (SDL_EnclosePoints(points, (int) count, NULL, &bounds)) {
+            SW_AddTilePrimitive(queue, SW_TILE_ALL, &bounds);
+        }
+    } else {
+        /* Copies hold a srcrect/dstrect pair, fills just the rect */
+        const size_t stride = (cmd->command == SDL_RENDERCMD_COPY) ? 2 : 1;
+        SDL_Rect *rect = (SDL_Rect *) verts + stride - 1;
+
+        for (i = 0; i < count; i++, rect += stride) {
+            rect->x += drawstate->viewport->x;
+            rect->y += drawstate->viewport->y;
+            SW_AddTilePrimitive(queue, (Uint32) i, rect);
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Sorts the binned primitives into the tiles they touch, keeping them in queue order */
+static SDL_bool SW_BinPrimitives(SW_TileQueue *queue, SDL_Surface *surface)
+{
+    const int tiles_x = (surface->w + SW_TILE_SIZE - 1) >> SW_TILE_SHIFT;
+    const int tiles_y = (surface->h + SW_TILE_SIZE - 1) >> SW_TILE_SHIFT;
+    const int num_tiles = tiles_x * tiles_y;
+    int num_bins = 0;
+    int pass, i, x, y;
+
+    if (!SW_GrowArray((void **) &queue->bin_start, &queue->max_tiles, num_tiles + 1, sizeof(*queue->bin_start))) {
+        return SDL_FALSE;
+    }
+    SDL_memset(queue->bin_start, 0, (num_tiles + 1) * sizeof(*queue->bin_start));
+
+    /* First count the primitives in each tile, then place them */
+    for (pass = 0; pass < 2; pass++) {
+        for (i = 0; i < queue->num_primitives; i++) {
+            const SDL_Rect *bounds = &queue->primitives[i].bounds;
+            const int x0 = bounds->x >> SW_TILE_SHIFT;
+            const int y0 = bounds->y >> SW_TILE_SHIFT;
+            const int x1 = (bounds->x + bounds->w - 1) >> SW_TILE_SHIFT;
+            const int y1 = (bounds->y + bounds->h - 1) >> SW_TILE_SHIFT;
+
+            for (y = y0; y <= y1; y++) {
+                for (x = x0; x <= x1; x++) {
+                    if (pass == 0) {
+                        queue->bin_start[y * tiles_x + x + 1]++;
+                    } else {
+                        queue->bins[queue->bin_start[y * tiles_x + x]++] = (Uint32) i;
+                    }
+                }
+            }
+        }
+
+        if (pass == 0) {
+            for (i = 0; i < num_tiles; i++) {
+                queue->bin_start[i + 1] += queue->bin_start[i];
+            }
+            num_bins = queue->bin_start[num_tiles];
+            if (!SW_GrowArray((void **) &queue->bins, &queue->max_bins, num_bins, sizeof(*queue->bins))) {
+                return SDL_FALSE;
+            }
+        }
+    }
+
+    /* Placing moved each start up to where the next tile starts */
+    SDL_memmove(&queue->bin_start[1], &queue->bin_start[0], num_tiles * sizeof(*queue->bin_start));
+    queue->bin_start[0] = 0;
+
+    queue->tiles_x = tiles_x;
+    queue->num_tiles = num_tiles;
+    return SDL_TRUE;
+}
+
+static void SW_FreeTileViews(SW_TileQueue *queue, SW_TileWorker *worker)
+{
+    int i;
+
+    if (worker->target) {
+        for (i = 0; i < queue->num_sources; i++) {
+            SDL_FreeSurface(worker->sources[i]);
+        }
+        SDL_FreeSurface(worker->target);
+        worker->target = NULL;
+    }
+}
+
+/* Workers draw through their own views of the target and textures, so their
+ * clip rects and mods don't clash with each other. */
+static SDL_bool SW_CreateTileViews(SW_TileQueue *queue, SW_TileWorker *worker, SDL_Surface *surface)
+{
+    int i;
+
+    if (!SW_GrowArray((void **) &worker->sources, &worker->max_sources, queue->num_sources, sizeof(*worker->sources))) {
+        return SDL_FALSE;
+    }
+    for (i = 0; i < queue->num_sources; i++) {
+        SDL_Surface *src = queue->sources[i];
+        worker->sources[i] = SDL_CreateRGBSurfaceWithFormatFrom(src->pixels, src->w, src->h, 0, src->pitch, src->format->format);
+        if (!worker->sources[i]) {
+            break;
+        }
+    }
+    if (i == queue->num_sources) {
+        worker->target = SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, surface->w, surface->h, 0, surface->pitch, surface->format->format);
+    }
+    if (!worker->target) {
+        while (i--) {
+            SDL_FreeSurface(worker->sources[i]);
+        }
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* Draws the binned commands, leaving the surface clip rect dirty */
+static void SW_FlushTiles(SW_TileQueue *queue, SDL_Surface *surface, SW_DrawStateCache *drawstate)
+{
+    SW_TileWorker *self = &queue->workers[0];
+    int num_workers = 1;
+    int i;
+
+    if (queue->num_primitives == 0) {
+        goto done;
+    }
+
+    /* The rendering thread draws into the target and textures themselves */
+    self->target = surface;
+    self->sources = queue->sources;
+
+    /* Small batches, or running out of memory, draw everything in order on this thread */
+    if (queue->num_primitives < SW_TILE_MIN_PRIMITIVES || !SW_BinPrimitives(queue, surface)) {
+        SDL_Rect area;
+        int last = -1;
+
+        area.x = 0;
+        area.y = 0;
+        area.w = surface->w;
+        area.h = surface->h;
+        for (i = 0; i < queue->num_primitives; i++) {
+            SW_DrawTilePrimitive(queue, self, &area, (Uint32) i, &last);
+        }
+        goto done;
+    }
+
+    for (i = 1; i < queue->num_workers; i++) {
+        if (SW_CreateTileViews(queue, &queue->workers[i], surface)) {
+            num_workers++;
+        }
+    }
+
+    SDL_AtomicSet(&queue->next_tile, 0);
+    if (num_workers > 1) {
+        SDL_LockMutex(queue->lock);
+        queue->generation++;
+        queue->busy = queue->num_workers - 1;
+        SDL_CondBroadcast(queue->work_cond);
+        SDL_UnlockMutex(queue->lock);
+    }
+
+    SW_RenderTiles(queue, self);
+
+    if (num_workers > 1) {
+        SDL_LockMutex(queue->lock);
+        while (queue->busy > 0) {
+            SDL_CondWait(queue->done_cond, queue->lock);
+        }
+        SDL_UnlockMutex(queue->lock);
+
+        for (i = 1; i < queue->num_workers; i++) {
+            SW_FreeTileViews(queue, &queue->workers[i]);
+        }
+    }
+
+done:
+    self->target = NULL;
+    self->sources = NULL;
+    queue->num_commands = 0;
+    queue->num_primitives = 0;
+    queue->num_sources = 0;
+    drawstate->surface_cliprect_dirty = SDL_TRUE;
+}
+
 static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_TileQueue *tiles = ((SW_RenderData *)renderer->driverdata)->tiles;
     SW_DrawStateCache drawstate;
 
     if (!surface) {
@@ -672,6 +1635,18 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
     drawstate.surface_cliprect_dirty = SDL_TRUE;
 
     while (cmd) {
+        if (tiles) {
+            if (SW_BinCommand(tiles, surface, cmd, vertices, &drawstate)) {
+                cmd = cmd->next;
+                continue;
+            }
+            /* Anything that draws has to wait for the binned commands before it */
+            if (cmd->command != SDL_RENDERCMD_SETVIEWPORT && cmd->command != SDL_RENDERCMD_SETCLIPRECT &&
+                cmd->command != SDL_RENDERCMD_SETDRAWCOLOR && cmd->command != SDL_RENDERCMD_NO_OP) {
+                SW_FlushTiles(tiles, surface, &drawstate);
+            }
+        }
+
         switch (cmd->command) {
             case SDL_RENDERCMD_SETDRAWCOLOR: {
                 break;  /* Not used in this backend. */
@@ -760,9 +1735,16 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 const Uint8 g = cmd->data.draw.g;
                 const Uint8 b = cmd->data.draw.b;
                 const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
+                int count = (int) cmd->data.draw.count;
                 SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
+
+                /* Fill the following same colored rects with this call too */
+                while (SW_SameFill(cmd, cmd->next)) {
+                    cmd = cmd->next;
+                    count += (int) cmd->data.draw.count;
+                }
+
                 SetDrawState(surface, &drawstate);
 
                 /* Apply viewport */
@@ -783,65 +1765,25 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             }
 
             case SDL_RENDERCMD_COPY: {
-                SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_Rect *srcrect = verts;
-                SDL_Rect *dstrect = verts + 1;
-                SDL_Texture *texture = cmd->data.draw.texture;
-                SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+                SW_BlendCopyFunc blend;
 
                 SetDrawState(surface, &drawstate);
 
                 PrepTextureForCopy(cmd);
+                blend = SW_GetBlendCopyFunc(surface, cmd);
 
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    dstrect->x += drawstate.viewport->x;
-                    dstrect->y += drawstate.viewport->y;
-                }
+                /* A run of copies from the same texture only changes the color and alpha mod */
+                for (;;) {
+                    SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                    SW_CopyRects(surface, cmd, &drawstate, verts, cmd->data.draw.count, SW_IsColorModulated(cmd) ? blend : NULL);
 
-                if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
-                    SDL_BlitSurface(src, srcrect, surface, dstrect);
-                } else {
-                    /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                     * to avoid potentially frequent RLE encoding/decoding.
-                     */
-                    SDL_SetSurfaceRLE(surface, 0);
-
-                    /* Prevent to do scaling + clipping on viewport boundaries as it may lose proportion */
-                    if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
-                        SDL_Surface *tmp = SDL_CreateRGBSurfaceWithFormat(0, dstrect->w, dstrect->h, 0, src->format->format);
-                        /* Scale to an intermediate surface, then blit */
-                        if (tmp) {
-                            SDL_Rect r;
-                            SDL_BlendMode blendmode;
-                            Uint8 alphaMod, rMod, gMod, bMod;
-
-                            SDL_GetSurfaceBlendMode(src, &blendmode);
-                            SDL_GetSurfaceAlphaMod(src, &alphaMod);
-                            SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
-
-                            r.x = 0;
-                            r.y = 0;
-                            r.w = dstrect->w;
-                            r.h = dstrect->h;
-
-                            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
-                            SDL_SetSurfaceColorMod(src, 255, 255, 255);
-                            SDL_SetSurfaceAlphaMod(src, 255);
-
-                            SDL_PrivateUpperBlitScaled(src, srcrect, tmp, &r, texture->scaleMode);
-
-                            SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
-                            SDL_SetSurfaceAlphaMod(tmp, alphaMod);
-                            SDL_SetSurfaceBlendMode(tmp, blendmode);
-
-                            SDL_BlitSurface(tmp, NULL, surface, dstrect);
-                            SDL_FreeSurface(tmp);
-                            /* No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy() */
-                        }
-                    } else{
-                        SDL_PrivateUpperBlitScaled(src, srcrect, surface, dstrect, texture->scaleMode);
+                    if (!SW_SameCopyState(cmd, cmd->next)) {
+                        break;
                     }
+                    if (!SW_SameColor(cmd, cmd->next)) {
+                        PrepTextureColorForCopy(cmd->next);
+                    }
+                    cmd = cmd->next;
                 }
                 break;
             }
@@ -928,6 +1870,10 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         cmd = cmd->next;
     }
 
+    if (tiles) {
+        SW_FlushTiles(tiles, surface, &drawstate);
+    }
+
     return 0;
 }
 
@@ -963,19 +1909,30 @@ static int SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
 
 static int SW_RenderPresent(SDL_Renderer *renderer)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
     SDL_Window *window = renderer->window;
 
     if (!window) {
         return -1;
     }
-    return SDL_UpdateWindowSurface(window);
+
+    /* The window still shows the last frame, only send what was drawn over it */
+    if (!data->present_all) {
+        if (SDL_RectEmpty(&renderer->damage)) {
+            return 0;
+        }
+        return SDL_UpdateWindowSurfaceRects(window, &renderer->damage, 1);
+    }
+    if (SDL_UpdateWindowSurface(window) < 0) {
+        return -1;
+    }
+    data->present_all = SDL_FALSE;
+    return 0;
 }
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
-    SDL_Surface *surface = (SDL_Surface *)texture->driverdata;
-
-    SDL_FreeSurface(surface);
+    SW_FreeTextureSurface((SDL_Surface *)texture->driverdata);
 }
 
 static void SW_DestroyRenderer(SDL_Renderer *renderer)
@@ -986,6 +1943,9 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
+    if (data) {
+        SW_DestroyTileQueue(data->tiles);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -994,6 +1954,8 @@ SDL_Renderer *SW_CreateRendererForSurface(SDL_Surface *surface)
 {
     SDL_Renderer *renderer;
     SW_RenderData *data;
+    const char *hint;
+    int num_threads;
 
     if (!surface) {
         SDL_InvalidParamError("surface");
@@ -1015,16 +1977,28 @@ SDL_Renderer *SW_CreateRendererForSurface(SDL_Surface *surface)
     data->surface = surface;
     data->window = surface;
 
+    hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    num_threads = hint ? SDL_atoi(hint) : 0;
+    if (num_threads < 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    if (num_threads > 1) {
+        /* Fall back to rendering serially if the threads can't be started */
+        data->tiles = SW_CreateTileQueue(num_threads);
+    }
+
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
     renderer->CreateTexture = SW_CreateTexture;
     renderer->UpdateTexture = SW_UpdateTexture;
+    renderer->ShareTexturePixels = SW_ShareTexturePixels;
     renderer->LockTexture = SW_LockTexture;
     renderer->UnlockTexture = SW_UnlockTexture;
     renderer->SetTextureScaleMode = SW_SetTextureScaleMode;
     renderer->SetRenderTarget = SW_SetRenderTarget;
     renderer->QueueSetViewport = SW_QueueSetViewport;
     renderer->QueueSetDrawColor = SW_QueueSetViewport; /* SetViewport and SetDrawColor are (currently) no-ops. */
+    renderer->draw_color_in_commands = SDL_TRUE;
     renderer->QueueDrawPoints = SW_QueueDrawPoints;
     renderer->QueueDrawLines = SW_QueueDrawPoints; /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = SW_QueueFillRects;
@@ -1046,6 +2020,7 @@ static SDL_Renderer *SW_CreateRenderer(SDL_Window *window, Uint32 flags)
 {
     const char *hint;
     SDL_Surface *surface;
+    SDL_Renderer *renderer;
     SDL_bool no_hint_set;
 
     /* Set the vsync hint based on our flags, if it's not already set */
@@ -1070,7 +2045,14 @@ static SDL_Renderer *SW_CreateRenderer(SDL_Window *window, Uint32 flags)
     if (!surface) {
         return NULL;
     }
-    return SW_CreateRendererForSurface(surface);
+
+    renderer = SW_CreateRendererForSurface(surface);
+    if (renderer) {
+        /* Present only the area drawn since the last frame */
+        ((SW_RenderData *)renderer->driverdata)->present_all = SDL_TRUE;
+        renderer->track_damage = SDL_TRUE;
+    }
+    return renderer;
 }
 
 SDL_RenderDriver SW_RenderDriver = {
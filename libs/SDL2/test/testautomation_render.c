@@ -811,6 +811,886 @@ int render_testBlitBlend(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * @brief Tests the render queue statistics.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_GetRenderStats
+ * http://wiki.libsdl.org/SDL_RenderPresent
+ */
+int render_testRenderStats(void *arg)
+{
+    int ret;
+    int i;
+    SDL_Rect rect;
+    SDL_RenderStats stats;
+    SDL_Texture *texture;
+    SDL_RendererInfo info;
+    Uint32 pixels[8 * 8];
+    int checkFailCount1;
+
+    /* The counts below assume draws are batched, so recreate the renderer with batching on. */
+    ret = SDL_GetRendererInfo(renderer, &info);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRendererInfo, expected: 0, got: %i", ret);
+    for (i = 0; i < SDL_GetNumRenderDrivers(); i++) {
+        SDL_RendererInfo driver;
+        if (SDL_GetRenderDriverInfo(i, &driver) == 0 && SDL_strcmp(driver.name, info.name) == 0) {
+            break;
+        }
+    }
+    SDL_DestroyRenderer(renderer);
+    SDL_SetHintWithPriority(SDL_HINT_RENDER_BATCHING, "1", SDL_HINT_OVERRIDE);
+    renderer = SDL_CreateRenderer(window, i < SDL_GetNumRenderDrivers() ? i : -1, 0);
+    SDL_ResetHint(SDL_HINT_RENDER_BATCHING);
+    SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRenderer result");
+    if (renderer == NULL) {
+        return TEST_ABORTED;
+    }
+
+    ret = SDL_GetRenderStats(renderer, NULL);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_GetRenderStats(renderer, NULL), expected: <0, got: %i", ret);
+
+    /* Clear surface, this also presents so the next frame starts with fresh counters. */
+    _clearScreen();
+
+    /* Replaced before anything is drawn, so it never reaches the backend. */
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = TESTRENDER_SCREEN_W / 2;
+    rect.h = TESTRENDER_SCREEN_H / 2;
+    ret = SDL_RenderSetViewport(renderer, &rect);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderSetViewport, expected: 0, got: %i", ret);
+    ret = SDL_RenderSetViewport(renderer, NULL);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderSetViewport, expected: 0, got: %i", ret);
+
+    /* Same color fills queued back to back share one command. Backends without their own
+       fill and copy commands draw those as geometry. */
+    ret = SDL_SetRenderDrawColor(renderer, 13, 73, 200, SDL_ALPHA_OPAQUE);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderDrawColor, expected: 0, got: %i", ret);
+    checkFailCount1 = 0;
+    rect.w = 8;
+    rect.h = 8;
+    for (i = 0; i < 8; i++) {
+        rect.x = i * 8;
+        rect.y = 0;
+        ret = SDL_RenderFillRect(renderer, &rect);
+        if (ret != 0) {
+            checkFailCount1++;
+        }
+    }
+    SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_RenderFillRect, expected: 0, got: %i", checkFailCount1);
+
+    /* Counters are published when the frame is presented. */
+    SDL_RenderPresent(renderer);
+
+    SDL_zero(stats);
+    ret = SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(stats.merged_commands == 7, "Validate merged commands, expected: 7, got: %u", (unsigned int)stats.merged_commands);
+    SDLTest_AssertCheck(stats.dropped_commands >= 1, "Validate dropped commands, expected: >=1, got: %u", (unsigned int)stats.dropped_commands);
+    SDLTest_AssertCheck(stats.fill_commands + stats.geometry_commands == 1, "Validate fill and geometry commands, expected: 1, got: %u",
+                        (unsigned int)(stats.fill_commands + stats.geometry_commands));
+    SDLTest_AssertCheck(stats.flushes == 1, "Validate flushes, expected: 1, got: %u", (unsigned int)stats.flushes);
+    SDLTest_AssertCheck(stats.vertex_bytes > 0, "Validate vertex bytes, expected: >0, got: %u", (unsigned int)stats.vertex_bytes);
+
+    /* Updating a texture the queue still uses flushes the queue first. */
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, 8, 8);
+    SDLTest_AssertCheck(texture != NULL, "Verify target texture is not NULL");
+    if (texture == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_memset(pixels, 0xAA, sizeof(pixels));
+    ret = SDL_RenderCopy(renderer, texture, NULL, &rect);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+    ret = SDL_UpdateTexture(texture, NULL, pixels, 8 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+    ret = SDL_RenderCopy(renderer, texture, NULL, &rect);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+
+    /* Drawing into the texture and back counts as two target switches. */
+    ret = SDL_SetRenderTarget(renderer, texture);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderTarget, expected: 0, got: %i", ret);
+    SDL_RenderClear(renderer);
+    ret = SDL_SetRenderTarget(renderer, NULL);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderTarget, expected: 0, got: %i", ret);
+    SDL_RenderPresent(renderer);
+
+    SDL_zero(stats);
+    ret = SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(stats.copy_commands + stats.geometry_commands == 2, "Validate copy and geometry commands, expected: 2, got: %u",
+                        (unsigned int)(stats.copy_commands + stats.geometry_commands));
+    SDLTest_AssertCheck(stats.texture_binds == 2, "Validate texture binds, expected: 2, got: %u", (unsigned int)stats.texture_binds);
+    SDLTest_AssertCheck(stats.texture_flushes == 1, "Validate texture flushes, expected: 1, got: %u", (unsigned int)stats.texture_flushes);
+    SDLTest_AssertCheck(stats.target_switches == 2, "Validate target switches, expected: 2, got: %u", (unsigned int)stats.target_switches);
+    SDLTest_AssertCheck(stats.clear_commands == 1, "Validate clear commands, expected: 1, got: %u", (unsigned int)stats.clear_commands);
+    SDLTest_AssertCheck(stats.draw_calls == 3, "Validate draw calls, expected: 3, got: %u", (unsigned int)stats.draw_calls);
+
+    SDL_DestroyTexture(texture);
+
+    return TEST_COMPLETED;
+}
+
+/* Copies parts of the face in a grid of cells, each with its own tint, one
+ * copy at a time or all in one batch. */
+static int
+_drawCopyGrid(SDL_Texture *tface, SDL_bool batch)
+{
+    SDL_Rect srcrects[48];
+    SDL_FRect dstrects[48];
+    SDL_Color colors[48];
+    int i, ret = 0;
+
+    for (i = 0; i < (int)SDL_arraysize(dstrects); i++) {
+        srcrects[i].x = (i * 5) % 24;
+        srcrects[i].y = (i * 7) % 24;
+        srcrects[i].w = 12;
+        srcrects[i].h = 10;
+        dstrects[i].x = (float)((i % 8) * 10 - 2);
+        dstrects[i].y = (float)((i / 8) * 10 + 1);
+        dstrects[i].w = (i % 5) ? 12.0f : 9.5f;
+        dstrects[i].h = 10.0f;
+        colors[i].r = (Uint8)(i * 5);
+        colors[i].g = (Uint8)(255 - i * 3);
+        colors[i].b = (Uint8)((i % 2) ? 255 : 60);
+        colors[i].a = (Uint8)(100 + i * 3);
+    }
+
+    if (batch) {
+        return SDL_RenderCopyBatch(renderer, tface, srcrects, dstrects, colors, SDL_arraysize(dstrects));
+    }
+    for (i = 0; i < (int)SDL_arraysize(dstrects); i++) {
+        SDL_SetTextureColorMod(tface, colors[i].r, colors[i].g, colors[i].b);
+        SDL_SetTextureAlphaMod(tface, colors[i].a);
+        ret |= SDL_RenderCopyF(renderer, tface, &srcrects[i], &dstrects[i]);
+    }
+    SDL_SetTextureColorMod(tface, 255, 255, 255);
+    SDL_SetTextureAlphaMod(tface, 255);
+    return ret;
+}
+
+/**
+ * @brief Tests that a batch of copies draws like the copies one by one
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_RenderCopyBatch
+ */
+int render_testRenderCopyBatch(void *arg)
+{
+    SDL_Texture *tface;
+    SDL_Surface *referenceSurface;
+    SDL_Rect rect;
+    SDL_FRect dstrect;
+    int ret;
+
+    tface = _loadTestFace();
+    SDLTest_AssertCheck(tface != NULL, "Verify _loadTestFace() result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+
+    dstrect.x = 0.0f;
+    dstrect.y = 0.0f;
+    dstrect.w = 10.0f;
+    dstrect.h = 10.0f;
+    ret = SDL_RenderCopyBatch(renderer, tface, NULL, NULL, NULL, 1);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_RenderCopyBatch with NULL dstrects, expected: <0, got: %i", ret);
+    ret = SDL_RenderCopyBatch(renderer, tface, NULL, &dstrect, NULL, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyBatch with no copies, expected: 0, got: %i", ret);
+
+    /* Draw the copies one by one for reference. */
+    _clearScreen();
+    ret = _drawCopyGrid(tface, SDL_FALSE);
+    SDLTest_AssertCheck(ret == 0, "Validate results from calls to SDL_RenderCopyF, expected: 0, got: %i", ret);
+    referenceSurface = SDL_CreateRGBSurfaceWithFormat(0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 32, RENDER_COMPARE_FORMAT);
+    SDLTest_AssertCheck(referenceSurface != NULL, "Verify reference surface is not NULL");
+    if (referenceSurface == NULL) {
+        SDL_DestroyTexture(tface);
+        return TEST_ABORTED;
+    }
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = TESTRENDER_SCREEN_W;
+    rect.h = TESTRENDER_SCREEN_H;
+    ret = SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, referenceSurface->pixels, referenceSurface->pitch);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+
+    /* The batch has to match exactly. */
+    _clearScreen();
+    ret = _drawCopyGrid(tface, SDL_TRUE);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyBatch, expected: 0, got: %i", ret);
+    _compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    SDL_FreeSurface(referenceSurface);
+    SDL_DestroyTexture(tface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that repeating a frame doesn't allocate memory
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_GetRenderStats
+ */
+int render_testRenderArena(void *arg)
+{
+    SDL_Rect rects[100];
+    SDL_Point points[50];
+    SDL_RenderStats stats;
+    int frame, i, ret;
+
+    for (i = 0; i < (int)SDL_arraysize(rects); i++) {
+        rects[i].x = (i % 10) * 8;
+        rects[i].y = (i / 10) * 8;
+        rects[i].w = 6;
+        rects[i].h = 6;
+    }
+    for (i = 0; i < (int)SDL_arraysize(points); i++) {
+        points[i].x = i * 3;
+        points[i].y = (i % 2) * 40 + 100;
+    }
+
+    /* The first frames size the command pool, vertex buffer and scratch memory. */
+    for (frame = 0; frame < 3; frame++) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(renderer);
+        for (i = 0; i < 20; i++) {
+            SDL_SetRenderDrawColor(renderer, i * 10, 255 - i * 10, 128, SDL_ALPHA_OPAQUE);
+            SDL_RenderFillRects(renderer, rects, SDL_arraysize(rects));
+            SDL_RenderDrawLines(renderer, points, SDL_arraysize(points));
+        }
+        SDL_RenderPresent(renderer);
+    }
+
+    SDL_zero(stats);
+    ret = SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(stats.allocations == 0, "Validate allocations, expected: 0, got: %u", (unsigned int)stats.allocations);
+    SDLTest_AssertCheck(stats.arena_bytes > 0, "Validate arena bytes, expected: >0, got: %u", (unsigned int)stats.arena_bytes);
+
+    return TEST_COMPLETED;
+}
+
+/* Draws fills, points, lines and copies through changing viewports and clip rects. */
+static void
+_drawThreadsScene(SDL_Renderer *swrenderer, SDL_Texture *face)
+{
+    SDL_Rect viewport, clip, rect, rects[32];
+    int i, j;
+
+    SDL_SetRenderDrawColor(swrenderer, 20, 40, 60, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(swrenderer);
+
+    viewport.x = 7;
+    viewport.y = 5;
+    viewport.w = TESTRENDER_SCREEN_W - 30;
+    viewport.h = TESTRENDER_SCREEN_H - 20;
+    clip.x = 50;
+    clip.y = 30;
+    clip.w = 200;
+    clip.h = 150;
+    for (i = 0; i < 200; i++) {
+        if (i == 50) {
+            SDL_RenderSetViewport(swrenderer, &viewport);
+        } else if (i == 100) {
+            SDL_RenderSetClipRect(swrenderer, &clip);
+        } else if (i == 150) {
+            SDL_RenderSetClipRect(swrenderer, NULL);
+            SDL_RenderSetViewport(swrenderer, NULL);
+        }
+
+        rect.x = (i * 37) % TESTRENDER_SCREEN_W - 20;
+        rect.y = (i * 23) % TESTRENDER_SCREEN_H - 20;
+        rect.w = 10 + i % 70;
+        rect.h = 10 + i % 50;
+        SDL_SetRenderDrawBlendMode(swrenderer, (i % 3) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(swrenderer, i, 255 - i, i * 7, 64 + i % 192);
+        SDL_RenderFillRect(swrenderer, &rect);
+        SDL_RenderDrawPoint(swrenderer, rect.x + rect.w, rect.y);
+        if (i % 40 == 0) {
+            SDL_RenderDrawLine(swrenderer, 0, rect.y, TESTRENDER_SCREEN_W, rect.y + rect.h);
+        }
+        if (i % 25 == 0) {
+            /* Enough rects in one command to be drawn on the worker threads */
+            for (j = 0; j < (int)SDL_arraysize(rects); j++) {
+                rects[j].x = rect.x + j * 9;
+                rects[j].y = rect.y + (j % 4) * 17;
+                rects[j].w = 7 + j;
+                rects[j].h = 15;
+            }
+            SDL_RenderFillRects(swrenderer, rects, SDL_arraysize(rects));
+        }
+
+        SDL_SetTextureColorMod(face, 255 - i, i, 128);
+        SDL_SetTextureAlphaMod(face, 100 + i % 156);
+        SDL_SetTextureBlendMode(face, (i % 2) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_ADD);
+        rect.w = (i % 10 == 0) ? 50 : 42; /* scaled now and then */
+        rect.h = 42;
+        SDL_RenderCopy(swrenderer, face, NULL, &rect);
+    }
+    SDL_RenderPresent(swrenderer);
+}
+
+/**
+ * @brief Tests that the software renderer draws the same with threads
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_HINT_RENDER_SOFTWARE_THREADS
+ */
+int render_testSoftwareThreads(void *arg)
+{
+    SDL_Surface *face = SDLTest_ImageFace();
+    SDL_Surface *surfaces[2];
+    SDL_Renderer *renderers[2];
+    SDL_Texture *textures[2];
+    int i, ret;
+
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < 2; i++) {
+        SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, i ? "4" : "1");
+        surfaces[i] = SDL_CreateRGBSurfaceWithFormat(0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(surfaces[i] != NULL, "Verify target surface is not NULL");
+        renderers[i] = surfaces[i] ? SDL_CreateSoftwareRenderer(surfaces[i]) : NULL;
+        SDLTest_AssertPass("Call to SDL_CreateSoftwareRenderer()");
+        SDLTest_AssertCheck(renderers[i] != NULL, "Verify software renderer is not NULL");
+        textures[i] = renderers[i] ? SDL_CreateTextureFromSurface(renderers[i], face) : NULL;
+        SDLTest_AssertCheck(textures[i] != NULL, "Verify face texture is not NULL");
+        if (textures[i]) {
+            _drawThreadsScene(renderers[i], textures[i]);
+        }
+    }
+    SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+
+    if (textures[0] && textures[1]) {
+        ret = SDLTest_CompareSurfaces(surfaces[1], surfaces[0], 0);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+    }
+
+    for (i = 0; i < 2; i++) {
+        if (textures[i]) {
+            SDL_DestroyTexture(textures[i]);
+        }
+        if (renderers[i]) {
+            SDL_DestroyRenderer(renderers[i]);
+        }
+        SDL_FreeSurface(surfaces[i]);
+    }
+    SDL_FreeSurface(face);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests color modulated, blended software renderer copies against SDL_BlitSurface
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/SDL_BlitSurface
+ */
+int render_testSoftwareBlendCopy(void *arg)
+{
+    const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888 };
+    SDL_Surface *face, *source;
+    int i, j, ret;
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    source = SDL_ConvertSurfaceFormat(face, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDLTest_AssertCheck(source != NULL, "Verify converted face surface is not NULL");
+    if (source == NULL) {
+        SDL_FreeSurface(face);
+        return TEST_ABORTED;
+    }
+    SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_BLEND);
+
+    for (i = 0; i < (int)SDL_arraysize(formats); i++) {
+        SDL_Surface *target = SDL_CreateRGBSurfaceWithFormat(0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 32, formats[i]);
+        SDL_Surface *reference = SDL_CreateRGBSurfaceWithFormat(0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 32, formats[i]);
+        SDL_Renderer *swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+        SDL_Texture *texture = swrenderer ? SDL_CreateTextureFromSurface(swrenderer, source) : NULL;
+
+        SDLTest_AssertCheck(texture != NULL, "Verify face texture on software renderer is not NULL");
+        if (texture == NULL || reference == NULL) {
+            SDL_DestroyRenderer(swrenderer);
+            SDL_FreeSurface(target);
+            SDL_FreeSurface(reference);
+            continue;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        /* A background with every channel varying, to blend onto */
+        for (j = 0; j < TESTRENDER_SCREEN_W * TESTRENDER_SCREEN_H; j++) {
+            const int x = j % TESTRENDER_SCREEN_W, y = j / TESTRENDER_SCREEN_W;
+            Uint32 *pixel = (Uint32 *)((Uint8 *)target->pixels + y * target->pitch) + x;
+            *pixel = SDL_MapRGBA(target->format, (Uint8)(x * 3), (Uint8)(y * 4 + x), (Uint8)(x * y), (Uint8)(x + y * 4));
+        }
+        SDL_SetSurfaceBlendMode(target, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(target, NULL, reference, NULL);
+
+        /* Same size copies within the face, some of them clipped by the edges */
+        for (j = 0; j < 12; j++) {
+            const Uint8 r = (Uint8)(j * 23 + 7), g = (Uint8)(254 - j * 19), b = (Uint8)(j * 11 + 31), a = (Uint8)((j % 3) ? 101 + j * 13 : 255);
+            SDL_Rect srcrect, dstrect;
+
+            srcrect.x = (j % 4) * 2;
+            srcrect.y = (j % 3) * 2;
+            srcrect.w = 12 + (j % 3) * 6;
+            srcrect.h = 10 + (j % 4) * 5;
+            dstrect.x = (j % 4) * 25 - 8;
+            dstrect.y = (j / 4) * 22 - 5;
+            dstrect.w = srcrect.w;
+            dstrect.h = srcrect.h;
+
+            SDL_SetTextureColorMod(texture, r, g, b);
+            SDL_SetTextureAlphaMod(texture, a);
+            ret = SDL_RenderCopy(swrenderer, texture, &srcrect, &dstrect);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+
+            SDL_SetSurfaceColorMod(source, r, g, b);
+            SDL_SetSurfaceAlphaMod(source, a);
+            SDL_BlitSurface(source, &srcrect, reference, &dstrect);
+        }
+        SDL_RenderPresent(swrenderer);
+
+        ret = SDLTest_CompareSurfaces(target, reference, 0);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+        SDL_DestroyTexture(texture);
+        SDL_DestroyRenderer(swrenderer);
+        SDL_FreeSurface(target);
+        SDL_FreeSurface(reference);
+    }
+
+    SDL_FreeSurface(source);
+    SDL_FreeSurface(face);
+
+    return TEST_COMPLETED;
+}
+
+static void
+_checkDamage(SDL_Texture *texture, int x, int y, int w, int h)
+{
+    SDL_Rect damage;
+    int ret;
+
+    SDL_zero(damage);
+    ret = SDL_GetTextureDamage(texture, &damage);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetTextureDamage, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(damage.x == x && damage.y == y && damage.w == w && damage.h == h,
+                        "Verify damage, expected: %i,%i %ix%i, got: %i,%i %ix%i", x, y, w, h, damage.x, damage.y, damage.w, damage.h);
+}
+
+/**
+ * @brief Tests damage tracking of render targets
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_SetTextureDamageTracking
+ * http://wiki.libsdl.org/SDL_GetTextureDamage
+ */
+int render_testTextureDamage(void *arg)
+{
+    SDL_Texture *target, *streaming;
+    SDL_Rect rect;
+    Uint32 pixels[4 * 3];
+    int ret;
+
+    if (!SDL_RenderTargetSupported(renderer)) {
+        SDLTest_Log("Render targets are not supported, skipping test");
+        return TEST_SKIPPED;
+    }
+
+    streaming = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 8, 8);
+    SDLTest_AssertCheck(streaming != NULL, "Verify streaming texture is not NULL");
+    if (streaming) {
+        ret = SDL_SetTextureDamageTracking(streaming, SDL_TRUE);
+        SDLTest_AssertCheck(ret < 0, "Validate result from SDL_SetTextureDamageTracking on a streaming texture, expected: <0, got: %i", ret);
+        SDL_DestroyTexture(streaming);
+    }
+
+    target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H);
+    SDLTest_AssertCheck(target != NULL, "Verify target texture is not NULL");
+    if (target == NULL) {
+        return TEST_ABORTED;
+    }
+    ret = SDL_GetTextureDamage(target, &rect);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_GetTextureDamage without tracking, expected: <0, got: %i", ret);
+    ret = SDL_SetTextureDamageTracking(target, SDL_TRUE);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetTextureDamageTracking, expected: 0, got: %i", ret);
+    _checkDamage(target, 0, 0, 0, 0);
+
+    ret = SDL_SetRenderTarget(renderer, target);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderTarget, expected: 0, got: %i", ret);
+
+    /* Draws add up to their bounds until the damage is read */
+    rect.x = 10;
+    rect.y = 10;
+    rect.w = 20;
+    rect.h = 5;
+    SDL_RenderFillRect(renderer, &rect);
+    SDL_RenderDrawPoint(renderer, 50, 40);
+    _checkDamage(target, 10, 10, 41, 31);
+    _checkDamage(target, 0, 0, 0, 0);
+
+    SDL_RenderDrawLine(renderer, 70, 2, 60, 12);
+    _checkDamage(target, 60, 2, 11, 11);
+
+    /* Draws are clipped like they are drawn */
+    rect.x = 5;
+    rect.y = 6;
+    rect.w = 10;
+    rect.h = 10;
+    SDL_RenderSetClipRect(renderer, &rect);
+    SDL_RenderFillRect(renderer, NULL);
+    SDL_RenderSetClipRect(renderer, NULL);
+    _checkDamage(target, 5, 6, 10, 10);
+
+    rect.x = 20;
+    rect.y = 20;
+    rect.w = 30;
+    rect.h = 30;
+    SDL_RenderSetViewport(renderer, &rect);
+    rect.x = -5;
+    rect.y = 25;
+    rect.w = 10;
+    rect.h = 10;
+    SDL_RenderFillRect(renderer, &rect);
+    SDL_RenderSetViewport(renderer, NULL);
+    _checkDamage(target, 20, 45, 5, 5);
+
+    /* Clears ignore the viewport and clip rect */
+    SDL_RenderClear(renderer);
+    _checkDamage(target, 0, 0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H);
+
+    /* Updates are damage too */
+    SDL_memset(pixels, 0xFF, sizeof(pixels));
+    rect.x = 70;
+    rect.y = 50;
+    rect.w = 4;
+    rect.h = 3;
+    ret = SDL_UpdateTexture(target, &rect, pixels, 4 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+    _checkDamage(target, 70, 50, 4, 3);
+
+    /* Draws to other targets don't damage it */
+    SDL_SetRenderTarget(renderer, NULL);
+    SDL_RenderFillRect(renderer, NULL);
+    _checkDamage(target, 0, 0, 0, 0);
+
+    SDL_DestroyTexture(target);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests queued texture updates against synchronous ones
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_QueueTextureUpdate
+ * http://wiki.libsdl.org/SDL_CreateTextureFromSurfaceAsync
+ * http://wiki.libsdl.org/SDL_SetTextureUploadBudget
+ */
+int render_testTextureUploadQueue(void *arg)
+{
+    const SDL_Rect rect = { 0, 0, 32, 32 };
+    SDL_Surface *face = NULL, *source = NULL, *red = NULL, *red24 = NULL, *expected = NULL, *actual = NULL;
+    SDL_Texture *sync = NULL, *async = NULL, *other = NULL, *target = NULL;
+    SDL_RenderStats stats;
+    Uint32 uploads;
+    int ret, i;
+    int returnValue = TEST_COMPLETED;
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    /* A format no renderer stores textures in, so the workers convert */
+    source = SDL_ConvertSurfaceFormat(face, SDL_PIXELFORMAT_RGB24, 0);
+    SDLTest_AssertCheck(source != NULL, "Verify RGB24 surface is not NULL");
+    red = SDL_CreateRGBSurfaceWithFormat(0, rect.w, rect.h, 32, SDL_PIXELFORMAT_ABGR8888);
+    red24 = SDL_CreateRGBSurfaceWithFormat(0, rect.w, rect.h, 24, SDL_PIXELFORMAT_RGB24);
+    expected = SDL_CreateRGBSurfaceWithFormat(0, rect.w, rect.h, 32, SDL_PIXELFORMAT_ARGB8888);
+    actual = SDL_CreateRGBSurfaceWithFormat(0, rect.w, rect.h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (source == NULL || red == NULL || red24 == NULL || expected == NULL || actual == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+
+    ret = SDL_QueueTextureUpdate(NULL, NULL, source);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_QueueTextureUpdate with a NULL texture, expected: <0, got: %i", ret);
+
+    /* The async texture is drawn right away, which waits for its contents */
+    sync = SDL_CreateTextureFromSurface(renderer, source);
+    async = SDL_CreateTextureFromSurfaceAsync(renderer, source);
+    SDLTest_AssertCheck(sync != NULL && async != NULL, "Verify textures are not NULL");
+    if (sync == NULL || async == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, sync, NULL, &rect);
+    SDL_RenderReadPixels(renderer, &rect, expected->format->format, expected->pixels, expected->pitch);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, async, NULL, &rect);
+    SDL_RenderReadPixels(renderer, &rect, actual->format->format, actual->pixels, actual->pitch);
+    ret = SDLTest_CompareSurfaces(actual, expected, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+    /* Updates of a texture are applied in order */
+    ret = SDL_FillRect(red, NULL, SDL_MapRGB(red->format, 255, 0, 0));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_FillRect, expected: 0, got: %i", ret);
+    ret = SDL_QueueTextureUpdate(async, NULL, red);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_QueueTextureUpdate, expected: 0, got: %i", ret);
+    ret = SDL_QueueTextureUpdate(async, NULL, source);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_QueueTextureUpdate, expected: 0, got: %i", ret);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, async, NULL, &rect);
+    SDL_RenderReadPixels(renderer, &rect, actual->format->format, actual->pixels, actual->pitch);
+    ret = SDLTest_CompareSurfaces(actual, expected, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+    /* Updates of the current render target are converted and done right away */
+    if (SDL_RenderTargetSupported(renderer)) {
+        target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, rect.w, rect.h);
+        SDLTest_AssertCheck(target != NULL, "Verify target texture is not NULL");
+        if (target == NULL) {
+            returnValue = TEST_ABORTED;
+            goto cleanup;
+        }
+        ret = SDL_FillRect(red24, NULL, SDL_MapRGB(red24->format, 255, 0, 0));
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_FillRect, expected: 0, got: %i", ret);
+        SDL_SetRenderTarget(renderer, target);
+        ret = SDL_QueueTextureUpdate(target, NULL, red24);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_QueueTextureUpdate, expected: 0, got: %i", ret);
+        SDL_RenderReadPixels(renderer, &rect, actual->format->format, actual->pixels, actual->pitch);
+        SDL_SetRenderTarget(renderer, NULL);
+        ret = SDL_FillRect(expected, NULL, 0xFFFF0000);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_FillRect, expected: 0, got: %i", ret);
+        ret = SDLTest_CompareSurfaces(actual, expected, 0);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+    }
+
+    /* The surface must cover the area */
+    other = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 64, 64);
+    SDLTest_AssertCheck(other != NULL, "Verify texture is not NULL");
+    if (other == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+    ret = SDL_QueueTextureUpdate(other, NULL, source);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_QueueTextureUpdate with a small surface, expected: <0, got: %i", ret);
+
+    /* With a budget, updates nobody waits for spread over frames */
+    SDL_RenderPresent(renderer);
+    ret = SDL_SetTextureUploadBudget(renderer, 1);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetTextureUploadBudget, expected: 0, got: %i", ret);
+    for (i = 0; i < 3; i++) {
+        SDL_Rect quarter;
+        quarter.x = i * 16;
+        quarter.y = 0;
+        quarter.w = 16;
+        quarter.h = 16;
+        ret = SDL_QueueTextureUpdate(other, &quarter, source);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_QueueTextureUpdate, expected: 0, got: %i", ret);
+    }
+    SDL_RenderPresent(renderer);
+    SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(stats.uploads <= 1, "Verify committed updates, expected: <=1, got: %i", (int)stats.uploads);
+    SDLTest_AssertCheck(stats.uploads + stats.uploads_pending == 3, "Verify committed and pending updates, expected: 3, got: %i", (int)(stats.uploads + stats.uploads_pending));
+    uploads = stats.uploads;
+
+    ret = SDL_FlushTextureUpdates(renderer);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_FlushTextureUpdates, expected: 0, got: %i", ret);
+    SDL_RenderPresent(renderer);
+    SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(uploads + stats.uploads == 3, "Verify committed updates, expected: 3, got: %i", (int)(uploads + stats.uploads));
+    SDLTest_AssertCheck(stats.upload_bytes == stats.uploads * 16 * 16 * 4, "Verify committed bytes, expected: %i, got: %i", (int)stats.uploads * 16 * 16 * 4, (int)stats.upload_bytes);
+    SDLTest_AssertCheck(stats.uploads_pending == 0, "Verify pending updates, expected: 0, got: %i", (int)stats.uploads_pending);
+    SDL_SetTextureUploadBudget(renderer, 0);
+
+    /* Destroying a texture drops its updates */
+    ret = SDL_QueueTextureUpdate(other, &rect, source);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_QueueTextureUpdate, expected: 0, got: %i", ret);
+    SDL_DestroyTexture(other);
+    other = NULL;
+    SDL_FlushTextureUpdates(renderer);
+    SDL_RenderPresent(renderer);
+    SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(stats.uploads == 0 && stats.uploads_pending == 0, "Verify dropped updates, expected: 0 and 0, got: %i and %i", (int)stats.uploads, (int)stats.uploads_pending);
+
+cleanup:
+    if (other) {
+        SDL_DestroyTexture(other);
+    }
+    if (target) {
+        SDL_DestroyTexture(target);
+    }
+    if (async) {
+        SDL_DestroyTexture(async);
+    }
+    if (sync) {
+        SDL_DestroyTexture(sync);
+    }
+    SDL_FreeSurface(actual);
+    SDL_FreeSurface(expected);
+    SDL_FreeSurface(red24);
+    SDL_FreeSurface(red);
+    SDL_FreeSurface(source);
+    SDL_FreeSurface(face);
+
+    return returnValue;
+}
+
+/**
+ * @brief Tests textures created in the renderer upload format
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_GetRendererUploadFormat
+ * http://wiki.libsdl.org/SDL_CreateTextureFromSurface
+ */
+int render_testUploadFormat(void *arg)
+{
+    const SDL_Rect rect = { 0, 0, 32, 32 };
+    const SDL_Rect corner = { 0, 0, 4, 4 };
+    SDL_Surface *face = NULL, *source = NULL, *copy = NULL, *rgb = NULL, *expected = NULL, *actual = NULL;
+    SDL_Texture *texture = NULL;
+    SDL_bool software;
+    SDL_RendererInfo info;
+    SDL_RenderStats stats;
+    Uint32 format, pixels[4 * 4];
+    int ret;
+    int returnValue = TEST_COMPLETED;
+
+    format = SDL_GetRendererUploadFormat(NULL, SDL_TRUE);
+    SDLTest_AssertCheck(format == SDL_PIXELFORMAT_UNKNOWN, "Validate result from SDL_GetRendererUploadFormat with a NULL renderer, expected: %s, got: %s",
+                        SDL_GetPixelFormatName(SDL_PIXELFORMAT_UNKNOWN), SDL_GetPixelFormatName(format));
+    format = SDL_GetRendererUploadFormat(renderer, SDL_TRUE);
+    SDLTest_AssertCheck(SDL_ISPIXELFORMAT_ALPHA(format), "Verify upload format has alpha, got: %s", SDL_GetPixelFormatName(format));
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    source = SDL_ConvertSurfaceFormat(face, format, 0);
+    copy = SDL_ConvertSurfaceFormat(face, format, 0);
+    expected = SDL_CreateRGBSurfaceWithFormat(0, rect.w, rect.h, 32, SDL_PIXELFORMAT_ARGB8888);
+    actual = SDL_CreateRGBSurfaceWithFormat(0, rect.w, rect.h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (source == NULL || copy == NULL || expected == NULL || actual == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+
+    /* Surfaces in the upload format go to the texture without conversion */
+    SDL_RenderPresent(renderer);
+    texture = SDL_CreateTextureFromSurface(renderer, source);
+    SDLTest_AssertCheck(texture != NULL, "Verify texture is not NULL");
+    if (texture == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, texture, NULL, &rect);
+    SDL_RenderReadPixels(renderer, &rect, expected->format->format, expected->pixels, expected->pitch);
+    SDL_DestroyTexture(texture);
+    SDL_RenderPresent(renderer);
+    SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(stats.converted_bytes == 0, "Verify converted bytes, expected: 0, got: %i", (int)stats.converted_bytes);
+
+    /* Others are converted */
+    rgb = SDL_ConvertSurfaceFormat(face, SDL_PIXELFORMAT_RGB24, 0);
+    texture = rgb ? SDL_CreateTextureFromSurface(renderer, rgb) : NULL;
+    SDLTest_AssertCheck(texture != NULL, "Verify texture is not NULL");
+    if (texture == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+    SDL_QueryTexture(texture, &format, NULL, NULL, NULL);
+    SDL_DestroyTexture(texture);
+    texture = NULL;
+    SDL_RenderPresent(renderer);
+    SDL_GetRenderStats(renderer, &stats);
+    if (format != rgb->format->format) {
+        SDLTest_AssertCheck(stats.converted_bytes == (Uint32)(rgb->w * rgb->h * SDL_BYTESPERPIXEL(format)), "Verify converted bytes, expected: %i, got: %i",
+                            rgb->w * rgb->h * SDL_BYTESPERPIXEL(format), (int)stats.converted_bytes);
+    }
+
+    /* Shared pixels are copied before an update */
+    software = (SDL_GetRendererInfo(renderer, &info) == 0 && SDL_strcmp(info.name, "software") == 0) ? SDL_TRUE : SDL_FALSE;
+    SDL_SetHint(SDL_HINT_RENDER_SHARE_SURFACE_PIXELS, "1");
+    texture = SDL_CreateTextureFromSurface(renderer, source);
+    SDLTest_AssertCheck(texture != NULL, "Verify texture is not NULL");
+    if (texture == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+    if (software) {
+        SDLTest_AssertCheck(source->refcount == 2, "Verify the texture shares the surface, expected: 2 references, got: %i", source->refcount);
+    }
+    SDL_memset(pixels, 0, sizeof(pixels));
+    ret = SDL_UpdateTexture(texture, &corner, pixels, 4 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(source->refcount == 1, "Verify the texture let go of the surface, expected: 1 reference, got: %i", source->refcount);
+    ret = SDLTest_CompareSurfaces(source, copy, 0);
+    SDLTest_AssertCheck(ret == 0, "Verify the surface is left alone by the update, expected: 0, got: %i", ret);
+    SDL_DestroyTexture(texture);
+    texture = NULL;
+
+    /* Surfaces with RLE acceleration are not shared, encoding frees their pixels */
+    ret = SDL_SetSurfaceRLE(copy, 1);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetSurfaceRLE, expected: 0, got: %i", ret);
+    texture = SDL_CreateTextureFromSurface(renderer, copy);
+    SDLTest_AssertCheck(texture != NULL, "Verify texture is not NULL");
+    if (texture == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+    SDLTest_AssertCheck(copy->refcount == 1, "Verify the texture does not share the surface, expected: 1 reference, got: %i", copy->refcount);
+    SDL_DestroyTexture(texture);
+    texture = NULL;
+
+    /* and outlive the surface */
+    texture = SDL_CreateTextureFromSurface(renderer, source);
+    SDL_SetHint(SDL_HINT_RENDER_SHARE_SURFACE_PIXELS, NULL);
+    SDLTest_AssertCheck(texture != NULL, "Verify texture is not NULL");
+    if (texture == NULL) {
+        returnValue = TEST_ABORTED;
+        goto cleanup;
+    }
+    SDL_FreeSurface(source);
+    source = NULL;
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, texture, NULL, &rect);
+    SDL_RenderReadPixels(renderer, &rect, actual->format->format, actual->pixels, actual->pitch);
+    ret = SDLTest_CompareSurfaces(actual, expected, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+cleanup:
+    SDL_SetHint(SDL_HINT_RENDER_SHARE_SURFACE_PIXELS, NULL);
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+    SDL_FreeSurface(actual);
+    SDL_FreeSurface(expected);
+    SDL_FreeSurface(rgb);
+    SDL_FreeSurface(copy);
+    SDL_FreeSurface(source);
+    SDL_FreeSurface(face);
+
+    return returnValue;
+}
+
 /**
  * @brief Checks to see if functionality is supported. Helper function.
  */
@@ -1161,9 +2041,41 @@ static const SDLTest_TestCaseReference renderTest7 = {
     (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED
 };
 
+static const SDLTest_TestCaseReference renderTest8 = {
+    (SDLTest_TestCaseFp)render_testRenderStats, "render_testRenderStats", "Tests render queue statistics", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest9 = {
+    (SDLTest_TestCaseFp)render_testSoftwareThreads, "render_testSoftwareThreads", "Tests threaded software rendering against serial", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest10 = {
+    (SDLTest_TestCaseFp)render_testRenderArena, "render_testRenderArena", "Tests that repeated frames reuse render queue memory", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest11 = {
+    (SDLTest_TestCaseFp)render_testRenderCopyBatch, "render_testRenderCopyBatch", "Tests batched copies against single copies", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest12 = {
+    (SDLTest_TestCaseFp)render_testSoftwareBlendCopy, "render_testSoftwareBlendCopy", "Tests color modulated software copies against SDL_BlitSurface", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest13 = {
+    (SDLTest_TestCaseFp)render_testTextureDamage, "render_testTextureDamage", "Tests damage tracking of render targets", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest14 = {
+    (SDLTest_TestCaseFp)render_testTextureUploadQueue, "render_testTextureUploadQueue", "Tests queued texture updates against synchronous ones", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest15 = {
+    (SDLTest_TestCaseFp)render_testUploadFormat, "render_testUploadFormat", "Tests textures created in the renderer upload format", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, &renderTest12, &renderTest13, &renderTest14, &renderTest15, NULL
 };
 
 /* Render test suite (global) */
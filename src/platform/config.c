@@ -5,48 +5,182 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
-// Config values with iOS-friendly defaults
-double custom_cell_width = 0;
-double custom_cell_height = 0;
-int custom_screen_width = 0;
-int custom_screen_height = 0;
-boolean force_portrait = false;
-boolean double_tap_lock = true;
-int double_tap_interval = 500;
-boolean dynamic_colors = true;
-boolean dpad_enabled = true;
-int dpad_width = 0;
-int dpad_x_pos = 0;
-int dpad_y_pos = 0;
-boolean allow_dpad_mode_change = true;
-boolean default_dpad_mode = true;  // Movement mode by default
-int long_press_interval = 750;
-int dpad_transparency = 75;
-int keyboard_visibility = 1;  // On-demand
-int zoom_mode = 1;  // Follow player
-double init_zoom = 2.0;
-boolean init_zoom_toggle = false;
-double max_zoom = 4.0;
-boolean smart_zoom = true;
-boolean left_panel_smart_zoom = true;
-int filter_mode = 2;  // Anisotropic
-int default_graphics_mode = 1;  // Tiles by default on iOS
-boolean tiles_animation = true;
-boolean blend_full_tiles = true;
+// Every persisted setting, with its iOS-friendly default. Ranges are inclusive; out-of-range
+// values are clamped on load. Changing this list changes the snapshot layout hash, so an older
+// settings.bin is ignored and the text file is read instead.
+// The globals and config_settings[] are both generated from it, so their defaults can't drift.
+#define CONFIG_SETTINGS(BOOLEAN_SETTING, INT_SETTING, DOUBLE_SETTING) \
+    DOUBLE_SETTING(custom_cell_width, 0, 0, 1000, INVALIDATES_RENDERER) \
+    DOUBLE_SETTING(custom_cell_height, 0, 0, 1000, INVALIDATES_RENDERER) \
+    INT_SETTING(custom_screen_width, 0, 0, 16384, INVALIDATES_RENDERER) \
+    INT_SETTING(custom_screen_height, 0, 0, 16384, INVALIDATES_RENDERER) \
+    BOOLEAN_SETTING(force_portrait, false, INVALIDATES_RENDERER) \
+    BOOLEAN_SETTING(double_tap_lock, true, INVALIDATES_NOTHING) \
+    INT_SETTING(double_tap_interval, 500, 0, 10000, INVALIDATES_NOTHING) \
+    BOOLEAN_SETTING(dynamic_colors, true, INVALIDATES_NOTHING) \
+    BOOLEAN_SETTING(dpad_enabled, true, INVALIDATES_LAYOUT) \
+    INT_SETTING(dpad_width, 0, 0, 16384, INVALIDATES_LAYOUT) \
+    INT_SETTING(dpad_x_pos, 0, 0, 16384, INVALIDATES_LAYOUT) \
+    INT_SETTING(dpad_y_pos, 0, 0, 16384, INVALIDATES_LAYOUT) \
+    BOOLEAN_SETTING(allow_dpad_mode_change, true, INVALIDATES_NOTHING) \
+    BOOLEAN_SETTING(default_dpad_mode, true, INVALIDATES_NOTHING) /* movement mode */ \
+    INT_SETTING(long_press_interval, 750, 0, 10000, INVALIDATES_NOTHING) \
+    INT_SETTING(dpad_transparency, 75, 0, 255, INVALIDATES_LAYOUT) \
+    INT_SETTING(keyboard_visibility, 1, 0, 2, INVALIDATES_NOTHING) /* on demand */ \
+    INT_SETTING(zoom_mode, 1, 0, 2, INVALIDATES_NOTHING) /* follow player */ \
+    DOUBLE_SETTING(init_zoom, 2.0, 1, 10, INVALIDATES_NOTHING) \
+    BOOLEAN_SETTING(init_zoom_toggle, false, INVALIDATES_NOTHING) \
+    DOUBLE_SETTING(max_zoom, 4.0, 1, 10, INVALIDATES_NOTHING) \
+    BOOLEAN_SETTING(smart_zoom, true, INVALIDATES_NOTHING) \
+    BOOLEAN_SETTING(left_panel_smart_zoom, true, INVALIDATES_NOTHING) \
+    INT_SETTING(filter_mode, 2, 0, 2, INVALIDATES_GLYPHS | INVALIDATES_LAYOUT) /* anisotropic */ \
+    INT_SETTING(default_graphics_mode, 1, 0, 2, INVALIDATES_NOTHING) /* tiles */ \
+    BOOLEAN_SETTING(tiles_animation, true, INVALIDATES_NOTHING) \
+    BOOLEAN_SETTING(blend_full_tiles, true, INVALIDATES_SCREEN)
+
+#define BOOLEAN_SETTING(var, def, invalidates) boolean var = def;
+#define INT_SETTING(var, def, lo, hi, invalidates) int var = def;
+#define DOUBLE_SETTING(var, def, lo, hi, invalidates) double var = def;
+CONFIG_SETTINGS(BOOLEAN_SETTING, INT_SETTING, DOUBLE_SETTING)
+#undef BOOLEAN_SETTING
+#undef INT_SETTING
+#undef DOUBLE_SETTING
 
 boolean dpad_mode = true;  // Start in movement mode
 boolean restart_game = false;
 boolean settings_changed = false;
 
+#define BOOLEAN_SETTING(var, def, invalidates) {#var, SETTING_BOOLEAN, &var, def, 0, 1, invalidates},
+#define INT_SETTING(var, def, lo, hi, invalidates) {#var, SETTING_INT, &var, def, lo, hi, invalidates},
+#define DOUBLE_SETTING(var, def, lo, hi, invalidates) {#var, SETTING_DOUBLE, &var, def, lo, hi, invalidates},
+
+const setting config_settings[] = {
+    CONFIG_SETTINGS(BOOLEAN_SETTING, INT_SETTING, DOUBLE_SETTING)
+};
+
+#undef BOOLEAN_SETTING
+#undef INT_SETTING
+#undef DOUBLE_SETTING
+
+const int config_settings_count = sizeof(config_settings) / sizeof(config_settings[0]);
+
+// Union of the invalidates flags of every setting changed since the caller last cleared it
+int settings_invalidated = INVALIDATES_NOTHING;
+
+// Setting names are looked up through a perfect hash: on first use we search for a seed under
+// which every registered name lands in its own slot, so a lookup is one hash and one strcmp.
+// With the table at most half full a seed turns up within a few thousand tries; should the
+// search still give up, lookups fall back to a linear scan.
+#define SETTINGS_HASH_SIZE 64
+#define SETTINGS_HASH_MAX_SEEDS 65536
+#define SETTING_LINE_MAX_LEN 256
+#define SETTINGS_SNAPSHOT_MAGIC "BCF1"
+#define SETTINGS_SNAPSHOT_VERSION 1
+
+_Static_assert(sizeof(config_settings) / sizeof(config_settings[0]) <= SETTINGS_HASH_SIZE / 2,
+               "too many settings for the perfect hash, grow SETTINGS_HASH_SIZE");
+
+static int8_t settings_hash[SETTINGS_HASH_SIZE];
+static uint32_t settings_hash_seed;
+static boolean settings_hash_ready = false;
+static boolean settings_hash_perfect = false;
+
+static uint32_t hash_setting_name(const char *name, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (; *name; name++) {
+        hash = (hash ^ (uint8_t)*name) * 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+static void build_settings_hash() {
+    for (uint32_t seed = 0; seed < SETTINGS_HASH_MAX_SEEDS && !settings_hash_perfect; seed++) {
+        boolean collision = false;
+        memset(settings_hash, -1, sizeof(settings_hash));
+        for (int i = 0; i < config_settings_count && !collision; i++) {
+            int slot = hash_setting_name(config_settings[i].name, seed) % SETTINGS_HASH_SIZE;
+            if (settings_hash[slot] >= 0) {
+                collision = true;
+            } else {
+                settings_hash[slot] = i;
+            }
+        }
+        if (!collision) {
+            settings_hash_seed = seed;
+            settings_hash_perfect = true;
+        }
+    }
+    settings_hash_ready = true;
+}
+
+const setting *find_setting(const char *name) {
+    if (!settings_hash_ready) {
+        build_settings_hash();
+    }
+    if (!settings_hash_perfect) {
+        for (int i = 0; i < config_settings_count; i++) {
+            if (strcmp(config_settings[i].name, name) == 0) {
+                return &config_settings[i];
+            }
+        }
+        return NULL;
+    }
+    int index = settings_hash[hash_setting_name(name, settings_hash_seed) % SETTINGS_HASH_SIZE];
+    if (index < 0 || strcmp(config_settings[index].name, name) != 0) {
+        return NULL;
+    }
+    return &config_settings[index];
+}
+
+static double get_setting_value(const setting *s) {
+    switch (s->type) {
+    case SETTING_BOOLEAN:
+        return *(boolean *)s->value;
+    case SETTING_INT:
+        return *(int *)s->value;
+    default:
+        return *(double *)s->value;
+    }
+}
+
+// Stores a value, clamped to the setting's range. Returns true if the stored value changed.
+boolean set_setting_value(const setting *s, double value) {
+    if (value != value) { // NaN
+        value = s->default_value;
+    }
+    value = max(s->min_value, min(value, s->max_value));
+    double previous = get_setting_value(s);
+    switch (s->type) {
+    case SETTING_BOOLEAN:
+        *(boolean *)s->value = (value != 0);
+        break;
+    case SETTING_INT:
+        *(int *)s->value = (int)value;
+        break;
+    default:
+        *(double *)s->value = value;
+        break;
+    }
+    if (s->value == &default_dpad_mode) {
+        dpad_mode = default_dpad_mode;
+    }
+    return get_setting_value(s) != previous;
+}
+
+// set_conf("", "") restores the defaults of these only; the others keep their loaded values
+static const char *const reset_setting_names[] = {
+    "dpad_enabled", "default_graphics_mode", "zoom_mode", "init_zoom", "max_zoom", "smart_zoom",
+};
+
 void init_default_config() {
-    // Set iOS-optimized defaults
-    dpad_enabled = true;
-    default_graphics_mode = 1;  // Tiles look better on mobile
-    zoom_mode = 1;
-    init_zoom = 2.0;
-    max_zoom = 4.0;
-    smart_zoom = true;
+    for (int i = 0; i < (int) (sizeof(reset_setting_names) / sizeof(reset_setting_names[0])); i++) {
+        const setting *s = find_setting(reset_setting_names[i]);
+        if (s != NULL) {
+            set_setting_value(s, s->default_value);
+        }
+    }
     dpad_mode = default_dpad_mode;
 }
 
@@ -56,61 +190,129 @@ void set_conf(const char *name, const char *value) {
         return;
     }
 
-    // Parse known settings
-    if (strcmp(name, "custom_cell_width") == 0) {
-        custom_cell_width = atof(value);
-    } else if (strcmp(name, "custom_cell_height") == 0) {
-        custom_cell_height = atof(value);
-    } else if (strcmp(name, "force_portrait") == 0) {
-        force_portrait = atoi(value);
-    } else if (strcmp(name, "dynamic_colors") == 0) {
-        dynamic_colors = atoi(value);
-    } else if (strcmp(name, "dpad_enabled") == 0) {
-        dpad_enabled = atoi(value);
-    } else if (strcmp(name, "dpad_width") == 0) {
-        dpad_width = atoi(value);
-    } else if (strcmp(name, "dpad_transparency") == 0) {
-        dpad_transparency = atoi(value);
-    } else if (strcmp(name, "default_dpad_mode") == 0) {
-        default_dpad_mode = atoi(value);
-        dpad_mode = default_dpad_mode;
-    } else if (strcmp(name, "zoom_mode") == 0) {
-        zoom_mode = atoi(value);
-    } else if (strcmp(name, "init_zoom") == 0) {
-        init_zoom = atof(value);
-    } else if (strcmp(name, "max_zoom") == 0) {
-        max_zoom = atof(value);
-    } else if (strcmp(name, "default_graphics_mode") == 0) {
-        default_graphics_mode = atoi(value);
-    } else if (strcmp(name, "tiles_animation") == 0) {
-        tiles_animation = atoi(value);
-    } else if (strcmp(name, "filter_mode") == 0) {
-        filter_mode = atoi(value);
-    } else if (strcmp(name, "double_tap_lock") == 0) {
-        double_tap_lock = atoi(value);
-    } else if (strcmp(name, "double_tap_interval") == 0) {
-        double_tap_interval = atoi(value);
-    } else if (strcmp(name, "long_press_interval") == 0) {
-        long_press_interval = atoi(value);
-    } else if (strcmp(name, "smart_zoom") == 0) {
-        smart_zoom = atoi(value);
+    const setting *s = find_setting(name);
+    if (s == NULL) {
+        return;
+    }
+    char *end;
+    double parsed = strtod(value, &end);
+    if (end != value && set_setting_value(s, parsed)) {
+        settings_invalidated |= s->invalidates;
+    }
+}
+
+// Identifies the registry layout a snapshot was written with
+static uint32_t settings_layout_hash() {
+    uint32_t hash = SETTINGS_SNAPSHOT_VERSION;
+    for (int i = 0; i < config_settings_count; i++) {
+        hash = hash_setting_name(config_settings[i].name, hash + config_settings[i].type);
+    }
+    return hash;
+}
+
+// The snapshot records the size and modification time of the settings.txt it was written
+// alongside, so a text file edited by hand or by a script since is read instead.
+typedef struct settings_snapshot_header {
+    char magic[4];
+    uint32_t layout;
+    uint32_t count;
+    uint32_t padding;
+    int64_t text_modified;
+    int64_t text_size;
+} settings_snapshot_header;
+
+static void settings_text_identity(int64_t *modified, int64_t *size) {
+    struct stat st;
+    if (stat(SETTINGS_FILE, &st) == 0) {
+        *modified = st.st_mtime;
+        *size = st.st_size;
+    } else {
+        *modified = *size = -1;
+    }
+}
+
+// Identity of settings.txt as of the last load or save, to notice edits while running
+static int64_t loaded_text_modified = -1, loaded_text_size = -1;
+
+static boolean load_settings_snapshot() {
+    FILE *f = fopen(SETTINGS_SNAPSHOT_FILE, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    settings_snapshot_header header;
+    double values[sizeof(config_settings) / sizeof(config_settings[0])];
+    int64_t text_modified, text_size;
+    settings_text_identity(&text_modified, &text_size);
+    boolean valid = fread(&header, sizeof(header), 1, f) == 1
+        && memcmp(header.magic, SETTINGS_SNAPSHOT_MAGIC, 4) == 0
+        && header.layout == settings_layout_hash()
+        && header.count == (uint32_t) config_settings_count
+        && header.text_modified == text_modified
+        && header.text_size == text_size
+        && fread(values, sizeof(double), config_settings_count, f) == (size_t) config_settings_count;
+    fclose(f);
+    if (!valid) {
+        return false;
+    }
+    for (int i = 0; i < config_settings_count; i++) {
+        if (set_setting_value(&config_settings[i], values[i])) {
+            settings_invalidated |= config_settings[i].invalidates;
+        }
+    }
+    return true;
+}
+
+static void save_settings_snapshot() {
+    settings_snapshot_header header = {.layout = settings_layout_hash(), .count = config_settings_count};
+    double values[sizeof(config_settings) / sizeof(config_settings[0])];
+    memcpy(header.magic, SETTINGS_SNAPSHOT_MAGIC, 4);
+    settings_text_identity(&header.text_modified, &header.text_size);
+    for (int i = 0; i < config_settings_count; i++) {
+        values[i] = get_setting_value(&config_settings[i]);
+    }
+
+    FILE *f = fopen(SETTINGS_SNAPSHOT_FILE ".tmp", "wb");
+    if (f == NULL) {
+        return;
+    }
+    boolean written = fwrite(&header, sizeof(header), 1, f) == 1
+        && fwrite(values, sizeof(double), config_settings_count, f) == (size_t) config_settings_count;
+    if (fclose(f) == 0 && written) {
+        rename(SETTINGS_SNAPSHOT_FILE ".tmp", SETTINGS_SNAPSHOT_FILE);
+    } else {
+        remove(SETTINGS_SNAPSHOT_FILE ".tmp");
     }
 }
 
 void load_conf() {
+    settings_text_identity(&loaded_text_modified, &loaded_text_size);
+    if (load_settings_snapshot()) {
+        return;
+    }
+
     FILE *f = fopen(SETTINGS_FILE, "r");
     if (f == NULL) {
         return;
     }
 
-    char name[SETTING_NAME_MAX_LEN];
-    char value[SETTING_VALUE_MAX_LEN];
-
-    while (fscanf(f, "%24s %10s", name, value) == 2) {
-        set_conf(name, value);
+    // One "name value" pair per line; blank lines and lines starting with '#' are ignored
+    char line[SETTING_LINE_MAX_LEN];
+    while (fgets(line, sizeof(line), f)) {
+        char *name = line + strspn(line, " \t");
+        if (*name == '#' || *name == '\n' || *name == '\0') {
+            continue;
+        }
+        char *value = name + strcspn(name, " \t\r\n");
+        if (*value == '\0' || *value == '\n') {
+            continue;
+        }
+        *value++ = '\0';
+        set_conf(name, value + strspn(value, " \t"));
     }
 
     fclose(f);
+    settings_text_identity(&loaded_text_modified, &loaded_text_size);
+    save_settings_snapshot();
 }
 
 void save_conf() {
@@ -119,17 +321,35 @@ void save_conf() {
         return;
     }
 
-    fprintf(f, "dpad_enabled %d\n", dpad_enabled);
-    fprintf(f, "default_dpad_mode %d\n", default_dpad_mode);
-    fprintf(f, "dpad_transparency %d\n", dpad_transparency);
-    fprintf(f, "zoom_mode %d\n", zoom_mode);
-    fprintf(f, "init_zoom %.1f\n", init_zoom);
-    fprintf(f, "max_zoom %.1f\n", max_zoom);
-    fprintf(f, "default_graphics_mode %d\n", default_graphics_mode);
-    fprintf(f, "tiles_animation %d\n", tiles_animation);
-    fprintf(f, "dynamic_colors %d\n", dynamic_colors);
-    fprintf(f, "smart_zoom %d\n", smart_zoom);
-    fprintf(f, "filter_mode %d\n", filter_mode);
+    for (int i = 0; i < config_settings_count; i++) {
+        const setting *s = &config_settings[i];
+        if (s->type == SETTING_DOUBLE) {
+            // shortest representation that reads back as the same double
+            double value = *(double *)s->value;
+            int precision = 6;
+            char text[32];
+            do {
+                snprintf(text, sizeof(text), "%.*g", precision++, value);
+            } while (precision <= 17 && strtod(text, NULL) != value);
+            fprintf(f, "%s %s\n", s->name, text);
+        } else {
+            fprintf(f, "%s %d\n", s->name, (int)get_setting_value(s));
+        }
+    }
 
     fclose(f);
+    settings_text_identity(&loaded_text_modified, &loaded_text_size);
+    save_settings_snapshot();
+}
+
+// Re-reads settings.txt if it changed since it was last loaded or saved. Changed settings are
+// accumulated in settings_invalidated for the caller to apply.
+boolean reload_conf_if_changed() {
+    int64_t modified, size;
+    settings_text_identity(&modified, &size);
+    if (modified == loaded_text_modified && size == loaded_text_size) {
+        return false;
+    }
+    load_conf();
+    return true;
 }
@@ -4,6 +4,7 @@
 #include <SDL_ttf.h>
 #include "display.h"
 #include "config.h"
+#include "input.h"
 #include <unistd.h>
 #include "IncludeGlobals.h"
 #include "platform.h"
@@ -28,12 +29,8 @@ SDL_Rect display;
 extern playerCharacter rogue;
 extern creature player;
 
-#define init_glyph_index(glyph, ascii, tile) \
-    glyph_index_table[glyph-MIN_TILE][0] = ascii; \
-    glyph_index_table[glyph-MIN_TILE][1] = tile; \
-    glyph_index_table[glyph-MIN_TILE][2] = tile + TILES_LEN;
 #define FONT_BOUND_CHAR 139
-#define TILES_LEN 256
+#define TILES_LEN GLYPH_TILE_FRAME_OFFSET
 #define MAX_GLYPH_NO (TILES_LEN * 3)
 #define MIN_TILE G_UP_ARROW
 #define TILES_FLIP_TIME 900
@@ -47,7 +44,6 @@ typedef struct {
 
 static TTF_Font *font;
 static glyph_cache font_cache[MAX_GLYPH_NO];
-static uint16_t glyph_index_table[TILES_LEN][3];
 static int font_width;
 static int font_height;
 
@@ -60,20 +56,23 @@ void draw_glyph(enum displayGlyph c, struct SDL_FRect rect, uint8_t r, uint8_t g
     if (font == NULL) {
         return; // Font not loaded, can't render
     }
-    boolean graphicsEnabled = (graphicsMode == TILES_GRAPHICS) || (graphicsMode == HYBRID_GRAPHICS && isEnvironmentGlyph(c));
-    int mode = graphicsEnabled * (1 + tiles_flipped);
-    uint16_t key;
-    if (c < MIN_TILE) {
-        key = c;
-    } else {
-        key = glyph_index_table[c - MIN_TILE][mode];
+    glyphInfo *info = NULL;
+    boolean graphicsEnabled = (graphicsMode == TILES_GRAPHICS);
+    if (c > GLYPH_TABLE_LAST) {
+        c = '?'; // a glyph newer than glyphTable
+    } else if (c >= MIN_TILE) {
+        info = &glyphTable[c - MIN_TILE];
+        graphicsEnabled |= (graphicsMode == HYBRID_GRAPHICS && info->environment);
     }
+    int mode = graphicsEnabled * (1 + tiles_flipped);
+    uint16_t key = info ? info->fontKey[mode] : c;
     glyph_cache *lc = &font_cache[key];
     if (lc->c == NULL) {
         struct SDL_Color fc = {COLOR_MAX, COLOR_MAX, COLOR_MAX};
         struct SDL_Surface *text;
         if ((key >= 2 * TILES_LEN) && !TTF_GlyphIsProvided(font, key)) {
-            glyph_index_table[c - MIN_TILE][mode] -= TILES_LEN;
+            // no alternate frame for this tile in the font; animate with the base tile
+            info->fontKey[mode] -= TILES_LEN;
             draw_glyph(c, rect, r, g, b);
             return;
         } else {
@@ -133,151 +132,21 @@ struct _TTF_Font *init_font_size(char *font_path, int size) {
     return NULL;
 }
 
-void init_glyph_index_table() {
-    init_glyph_index(G_UP_ARROW, 128 + 8, 128 + 8)
-    init_glyph_index(G_DOWN_ARROW, 144 + 1, 144 + 1)
-    init_glyph_index(G_PLAYER, '@', 256)
-    // G_EASY removed in newer BrogueCE
-    init_glyph_index(G_FOOD, ';', 258)
-    init_glyph_index(G_GOLD, '*', 259)
-    init_glyph_index(G_ARMOR, '[', 260)
-    init_glyph_index(G_WEAPON, 128 + 8, 261)
-    init_glyph_index(G_POTION, '!', 262)
-    init_glyph_index(G_SCROLL, 128 + 6, 263)
-    init_glyph_index(G_RING, 128 + 7, 264)
-    init_glyph_index(G_STAFF, '\\', 265)
-    init_glyph_index(G_WAND, '~', 266)
-    init_glyph_index(G_CHARM, 144 + 9, 267)
-    init_glyph_index(G_ANCIENT_SPIRIT, 'M', 268)
-    init_glyph_index(G_BAT, 'v', 269)
-    init_glyph_index(G_BLOAT, 'b', 270)
-    init_glyph_index(G_BOG_MONSTER, 'B', 271)
-    init_glyph_index(G_CENTAUR, 'C', 272)
-    init_glyph_index(G_CENTIPEDE, 'c', 273)
-    init_glyph_index(G_DAR_BATTLEMAGE, 'd', 274)
-    init_glyph_index(G_DAR_BLADEMASTER, 'd', 275)
-    init_glyph_index(G_DAR_PRIESTESS, 'd', 276)
-    init_glyph_index(G_DRAGON, 'D', 277)
-    init_glyph_index(G_EEL, 'e', 278)
-    init_glyph_index(G_EGG, 128 + 9, 279)
-    init_glyph_index(G_FLAMEDANCER, 'F', 280)
-    init_glyph_index(G_FURY, 'f', 281)
-    init_glyph_index(G_GOBLIN, 'g', 282)
-    init_glyph_index(G_GOBLIN_CHIEFTAN, 'g', 283)
-    init_glyph_index(G_GOBLIN_MAGIC, 'g', 284)
-    init_glyph_index(G_GOLEM, 'G', 285)
-    init_glyph_index(G_GUARDIAN, 223, 286)
-    init_glyph_index(G_IFRIT, 'I', 287)
-    init_glyph_index(G_IMP, 'i', 288)
-    init_glyph_index(G_JACKAL, 'j', 289)
-    init_glyph_index(G_JELLY, 'J', 290)
-    init_glyph_index(G_KOBOLD, 'k', 291)
-    init_glyph_index(G_KRAKEN, 'K', 292)
-    init_glyph_index(G_LICH, 'L', 293)
-    init_glyph_index(G_MONKEY, 'm', 294)
-    init_glyph_index(G_MOUND, 'a', 295)
-    init_glyph_index(G_NAGA, 'N', 296)
-    init_glyph_index(G_OGRE, 'O', 297)
-    init_glyph_index(G_OGRE_MAGIC, 'O', 298)
-    init_glyph_index(G_PHANTOM, 'P', 299)
-    init_glyph_index(G_PHOENIX, 'P', 300)
-    init_glyph_index(G_PIXIE, 'p', 301)
-    init_glyph_index(G_RAT, 'r', 302)
-    init_glyph_index(G_REVENANT, 'R', 303)
-    init_glyph_index(G_SALAMANDER, 'S', 304)
-    init_glyph_index(G_SPIDER, 's', 305)
-    init_glyph_index(G_TENTACLE_HORROR, 'H', 306)
-    init_glyph_index(G_TOAD, 't', 307)
-    init_glyph_index(G_TOTEM, 128 + 10, 308)
-    init_glyph_index(G_TROLL, 'T', 309)
-    init_glyph_index(G_TURRET, 128 + 9, 310)
-    init_glyph_index(G_UNDERWORM, 'U', 311)
-    init_glyph_index(G_UNICORN, 218, 312)
-    init_glyph_index(G_VAMPIRE, 'V', 313)
-    init_glyph_index(G_WARDEN, 'Y', 314)
-    init_glyph_index(G_WINGED_GUARDIAN, 223, 315)
-    init_glyph_index(G_WISP, 'w', 316)
-    init_glyph_index(G_WRAITH, 'W', 317)
-    init_glyph_index(G_ZOMBIE, 'Z', 318)
-    init_glyph_index(G_GOOD_MAGIC, 128 + 13, 319)
-    // G_GOOD_ITEM removed in newer BrogueCE
-    init_glyph_index(G_BAD_MAGIC, 128 + 12, 321)
-    // G_BAD_ITEM removed in newer BrogueCE
-    init_glyph_index(G_AMULET, 128 + 5, 323)
-    // G_AMULET_ITEM removed in newer BrogueCE
-    init_glyph_index(G_FLOOR, '.', 325)
-    init_glyph_index(G_FLOOR_ALT, '.', 326)
-    init_glyph_index(G_LIQUID, '~', 327)
-    init_glyph_index(G_CHASM, 128 + 1, 328)
-    // G_HOLE removed in newer BrogueCE
-    init_glyph_index(G_FIRE, 128 + 3, 330)
-    init_glyph_index(G_TORCH, '#', 331)
-    // G_FALLEN_TORCH removed in newer BrogueCE
-    init_glyph_index(G_ASHES, '\'', 333)
-    init_glyph_index(G_RUBBLE, ',', 334)
-    init_glyph_index(G_BONES, ',', 335)
-    init_glyph_index(G_CARPET, '.', 336)
-    init_glyph_index(G_BOG, ',', 337)
-    init_glyph_index(G_BEDROLL, '=', 338)
-    init_glyph_index(G_GRASS, '"', 339)
-    init_glyph_index(G_FOLIAGE, 128 + 4, 340)
-    init_glyph_index(G_BLOODWORT_STALK, 128 + 4, 341)
-    init_glyph_index(G_BLOODWORT_POD, '*', 342)
-    // G_SACRED_GLYPH, G_GLOWING_GLYPH removed in newer BrogueCE
-    init_glyph_index(G_MAGIC_GLYPH, 128 + 1, 345)
-    init_glyph_index(G_STATUE, 223, 346)
-    init_glyph_index(G_CRACKED_STATUE, 223, 347)
-    init_glyph_index(G_WALL, '#', 348)
-    init_glyph_index(G_WALL_TOP, '#', 349)
-    init_glyph_index(G_GRANITE, '#', 350)
-    // G_CRYSTAL_WALL removed in newer BrogueCE
-    init_glyph_index(G_CRYSTAL, '#', 352)
-    init_glyph_index(G_ELECTRIC_CRYSTAL, 164, 353)
-    init_glyph_index(G_OPEN_DOOR, '\'', 354)
-    init_glyph_index(G_CLOSED_DOOR, '+', 355)
-    init_glyph_index(G_OPEN_IRON_DOOR, '\'', 356)
-    init_glyph_index(G_CLOSED_IRON_DOOR, '+', 357)
-    init_glyph_index(G_PORTCULLIS, '#', 358)
-    init_glyph_index(G_DOORWAY, 144 + 6, 359)
-    init_glyph_index(G_UP_STAIRS, '<', 360)
-    init_glyph_index(G_DOWN_STAIRS, '>', 361)
-    init_glyph_index(G_BRIDGE, '=', 362)
-    init_glyph_index(G_BARRICADE, '#', 363)
-    init_glyph_index(G_KEY, '-', 364)
-    init_glyph_index(G_DEWAR, '&', 365)
-    init_glyph_index(G_CLOSED_CAGE, '#', 366)
-    init_glyph_index(G_OPEN_CAGE, '|', 367)
-    init_glyph_index(G_ALTAR, '|', 368)
-    init_glyph_index(G_LEVER, '/', 369)
-    init_glyph_index(G_LEVER_PULLED, '\\', 370)
-    init_glyph_index(G_TRAP, 128 + 2, 371)
-    // Various trap subtypes removed in newer BrogueCE - they all use G_TRAP now
-    init_glyph_index(G_VENT, '=', 381)
-    init_glyph_index(G_WEB, ':', 382)
-    init_glyph_index(G_NET, ':', 383)
-    init_glyph_index(G_VINE, ':', 384)
-    init_glyph_index(G_GEM, 128 + 9, 385)
-    init_glyph_index(G_PEDESTAL, '|', 386)
-    init_glyph_index(G_CLOSED_COFFIN, '|', 387)
-    init_glyph_index(G_OPEN_COFFIN, '|', 388)
-    init_glyph_index(G_CHAIN_LEFT, '-', 389)
-    init_glyph_index(G_CHAIN_TOP, '|', 390)
-    init_glyph_index(G_CHAIN_TOP_LEFT, '\\', 391)
-    init_glyph_index(G_CHAIN_BOTTOM_LEFT, '/', 392)
-    init_glyph_index(G_CHAIN_RIGHT, '-', 393)
-    init_glyph_index(G_CHAIN_BOTTOM, '|', 394)
-    init_glyph_index(G_CHAIN_BOTTOM_RIGHT, '\\', 395)
-    init_glyph_index(G_CHAIN_TOP_RIGHT, '/', 396)
-    init_glyph_index(G_LICHEN, '"', 339)
-    init_glyph_index(G_ORB_ALTAR, '|', 368)
-    init_glyph_index(G_SAC_ALTAR, '|', 368)
-    init_glyph_index(G_PIPES, '+', '+')
-}
-
 void init_glyphs() {
     memset(font_cache, 0, MAX_GLYPH_NO * sizeof(glyph_cache));
 }
 
+// Drops every cached glyph texture while keeping the renderer, so glyphs are re-rendered
+// with the current settings on their next use
+void reset_glyph_cache() {
+    for (int i = 0; i < MAX_GLYPH_NO; i++) {
+        if (font_cache[i].c) {
+            SDL_DestroyTexture(font_cache[i].c);
+        }
+    }
+    init_glyphs();
+}
+
 boolean init_font() {
     // On iOS, assets are in the app bundle - use SDL_GetBasePath() to find them
     char *base_path = SDL_GetBasePath();
@@ -307,7 +176,6 @@ boolean init_font() {
             TTF_GlyphMetrics(font, FONT_BOUND_CHAR, &minx, &maxx, &miny, &maxy, NULL);
             font_width = maxx - minx;
             font_height = maxy - miny;
-            init_glyph_index_table();
             return true;
         }
     }
@@ -376,6 +244,7 @@ void draw_screen() {
         }
 
         SDL_RenderPresent(renderer);
+        input_frame_presented();
         SDL_SetRenderTarget(renderer, screen_texture);
     }
 }
@@ -3,9 +3,36 @@
 
 #include "Rogue.h"
 
-#define SETTING_NAME_MAX_LEN 25
-#define SETTING_VALUE_MAX_LEN 11
 #define SETTINGS_FILE "settings.txt"
+#define SETTINGS_SNAPSHOT_FILE "settings.bin"
+
+enum settingType {
+    SETTING_BOOLEAN,
+    SETTING_INT,
+    SETTING_DOUBLE,
+};
+
+// What has to be rebuilt when a setting changes while the game is running
+enum settingInvalidation {
+    INVALIDATES_NOTHING = 0,   // read each time it is used
+    INVALIDATES_SCREEN = 1,    // the screen has to be redrawn
+    INVALIDATES_LAYOUT = 2,    // D-pad geometry and textures
+    INVALIDATES_GLYPHS = 4,    // cached glyph textures
+    INVALIDATES_RENDERER = 8,  // window, renderer, font size and every texture
+};
+
+// A persisted setting (see config_settings[] in config.c)
+typedef struct setting {
+    const char *name;
+    enum settingType type;
+    void *value;
+    double default_value;
+    double min_value, max_value;
+    int invalidates; // enum settingInvalidation flags
+} setting;
+
+extern const setting config_settings[];
+extern const int config_settings_count;
 
 // Config Values - iOS defaults
 extern double custom_cell_width;
@@ -39,10 +66,14 @@ extern boolean blend_full_tiles;
 extern boolean dpad_mode;
 extern boolean restart_game;
 extern boolean settings_changed;
+extern int settings_invalidated;
 
+const setting *find_setting(const char *name);
+boolean set_setting_value(const setting *s, double value);
 void set_conf(const char *name, const char *value);
 void load_conf();
 void save_conf();
+boolean reload_conf_if_changed();
 void init_default_config();
 
 #endif
@@ -31,6 +31,7 @@ extern double display_scale;  // High DPI scale factor (pixels / points)
 
 boolean init_font();
 void init_glyphs();
+void reset_glyph_cache();
 void destroy_font();
 void draw_glyph(enum displayGlyph c, struct SDL_FRect rect, uint8_t r, uint8_t g, uint8_t b);
 void draw_screen();
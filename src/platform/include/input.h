@@ -1,16 +1,50 @@
 #ifndef _input_h_
 #define _input_h_
 
+#include <SDL.h>
 #include "Rogue.h"
 
+#define INPUT_LATENCY_BUCKETS 12
+
+// Time from an input event to the first frame presented after the game received it.
+// Bucket i counts latencies below 2^i ms (the last bucket takes everything above).
+typedef struct {
+    uint32_t buckets[INPUT_LATENCY_BUCKETS];
+    uint32_t samples;
+    uint32_t max_ms;
+    uint64_t total_ms;
+    uint32_t coalesced;  // cursor moves merged into a later one
+    uint32_t dropped;    // events lost to a full queue
+} input_latency_histogram;
+
+enum hitRegionKind {
+    HIT_NONE,        // off the screen; x, y is the nearest cell
+    HIT_SCREEN,      // anywhere else on screen; x, y is the cell
+    HIT_LEFT_PANEL,  // the sidebar; x, y is the cell
+    HIT_GRID,        // the dungeon view; x, y is the cell, accounting for zoom
+    HIT_DPAD,        // x, y is the direction (-1, 0 or 1 on each axis)
+    HIT_BUTTON,      // x is the button from add_touch_button
+};
+
+typedef struct {
+    enum hitRegionKind region;
+    short x, y;
+} hit_result;
+
 extern rogueEvent current_event;
 
 boolean process_events();
+void input_frame_presented();
+const input_latency_histogram *get_input_latency_histogram();
 
 extern boolean ctrl_pressed;
 extern boolean requires_text_input;
 extern boolean virtual_keyboard_active;
 
+hit_result hit_test(double x, double y);
+int add_touch_button(SDL_Rect area, signed long key);
+void remove_touch_button(int button);
+
 void start_text_input();
 void stop_text_input();
 
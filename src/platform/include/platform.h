@@ -85,12 +85,65 @@ struct brogueConsole {
     enum graphicsModes (*setGraphicsMode)(enum graphicsModes mode);
 };
 
+// Aggregated run history stats, persisted in the run history file
+typedef struct runHistoryStats {
+    int32_t games;
+    int32_t won;
+    int32_t escaped;
+    int32_t mastered;
+    int32_t deepestLevel;
+    int32_t highestScore;
+    int32_t mostGold;
+    int32_t mostLumenstones;
+    int32_t fewestTurnsWin; // zero means never won
+    int32_t currentWinStreak;
+    int32_t longestWinStreak;
+    int32_t currentMasteryStreak;
+    int32_t longestMasteryStreak;
+    int32_t padding;
+    int64_t cumulativeScore;
+    int64_t cumulativeGold;
+    int64_t cumulativeLevels;
+    int64_t cumulativeTurns;
+} runHistoryStats;
+
+// Run history loaded in a single allocation (see loadRunHistoryArena)
+typedef struct runHistoryArena {
+    rogueRun *runs; // contiguous, in file order
+    int count;
+} runHistoryArena;
+
+typedef struct runHistoryIterator {
+    const runHistoryArena *arena;
+    int index;
+} runHistoryIterator;
+
+// Font glyphs between a tile and its alternate animation frame
+#define GLYPH_TILE_FRAME_OFFSET 256
+// The last enum displayGlyph. Rogue.h has no end marker, so this must follow it there;
+// lookups treat any glyph past it as unknown instead of reading past glyphTable
+#define GLYPH_TABLE_LAST G_LEFT_TRIANGLE
+#define GLYPH_TABLE_SIZE (GLYPH_TABLE_LAST - G_UP_ARROW + 1)
+
+// How to draw a displayGlyph >= G_UP_ARROW (see glyphTable)
+typedef struct glyphInfo {
+    uint32_t unicode;     // codepoint for text consoles
+    uint16_t fontKey[3];  // font glyph in text, tile and alternate tile mode
+    boolean environment;  // dungeon feature rather than an item or creature
+} glyphInfo;
+
 // defined in platform
 void loadKeymap(void);
 void dumpScores(void);
 unsigned int glyphToUnicode(enum displayGlyph glyph);
 boolean isEnvironmentGlyph(enum displayGlyph glyph);
+extern glyphInfo glyphTable[GLYPH_TABLE_SIZE];
 void setHighScoresFilename(char *buffer, int bufferMaxLength);
+boolean getRunHistoryStats(runHistoryStats *allTime, runHistoryStats *recent);
+runHistoryArena *loadRunHistoryArena(void);
+void freeRunHistoryArena(runHistoryArena *arena);
+const rogueRun *nextRunInHistory(runHistoryIterator *iterator);
+void freeRunHistory(rogueRun *runHistory);
 
 // iOS Touch Screen Console
 extern struct brogueConsole TouchScreenConsole;
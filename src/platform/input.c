@@ -3,6 +3,9 @@
 
 #include "input.h"
 #include <SDL.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
 #include "display.h"
 #include "config.h"
 #include "IncludeGlobals.h"
@@ -16,6 +19,30 @@ typedef enum {
     unset,
 } bool_store;
 
+#define INPUT_QUEUE_SIZE 64  // power of two
+
+typedef struct {
+    rogueEvent event;
+    uint32_t timestamp;  // SDL timestamp of the oldest input merged into this event
+} queued_event;
+
+// Translated events waiting for the game, as a single-producer single-consumer ring: the
+// producer only writes head and the consumer only writes tail, so neither side locks.
+static struct {
+    queued_event slots[INPUT_QUEUE_SIZE];
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+} input_queue;
+
+// The most recent translated event is held back until the next one shows whether it can be
+// merged; it is published at the end of each poll.
+static queued_event staged;
+static boolean has_staged = false;
+
+static boolean awaiting_present = false;
+static uint32_t awaiting_present_since;
+static input_latency_histogram latency_histogram;
+
 rogueEvent current_event;
 boolean ctrl_pressed = false;
 boolean requires_text_input = false;
@@ -35,6 +62,217 @@ void stop_text_input() {
     }
 }
 
+static boolean queue_push(const queued_event *e) {
+    uint32_t head = atomic_load_explicit(&input_queue.head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&input_queue.tail, memory_order_acquire) == INPUT_QUEUE_SIZE) {
+        return false;
+    }
+    input_queue.slots[head % INPUT_QUEUE_SIZE] = *e;
+    atomic_store_explicit(&input_queue.head, head + 1, memory_order_release);
+    return true;
+}
+
+static boolean queue_pop(queued_event *e) {
+    uint32_t tail = atomic_load_explicit(&input_queue.tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&input_queue.head, memory_order_acquire)) {
+        return false;
+    }
+    *e = input_queue.slots[tail % INPUT_QUEUE_SIZE];
+    atomic_store_explicit(&input_queue.tail, tail + 1, memory_order_release);
+    return true;
+}
+
+static void flush_staged() {
+    if (has_staged) {
+        if (!queue_push(&staged)) {
+            latency_histogram.dropped++;
+        }
+        has_staged = false;
+    }
+}
+
+// Queues a translated event. Consecutive cursor moves collapse into the last one, keeping the
+// timestamp of the first so latency is measured from when the finger actually moved.
+static void emit_event(const rogueEvent *event, uint32_t timestamp) {
+    if (has_staged && staged.event.eventType == MOUSE_ENTERED_CELL && event->eventType == MOUSE_ENTERED_CELL) {
+        staged.event = *event;
+        latency_histogram.coalesced++;
+        return;
+    }
+    flush_staged();
+    staged.event = *event;
+    staged.timestamp = timestamp;
+    has_staged = true;
+}
+
+// Touch hit-testing. The screen is divided into HIT_BLOCK x HIT_BLOCK pixel blocks, each
+// holding the region that covers it, so a touch resolves with one table load. Blocks that
+// straddle a region edge are marked HIT_BLOCK_MIXED and resolved against the region rects.
+// The table is rebuilt whenever the layout it was built from changes; zoom only changes how
+// grid coordinates map to cells, which is applied after the lookup.
+#define HIT_BLOCK_SHIFT 4
+#define HIT_BLOCK (1 << HIT_BLOCK_SHIFT)
+#define MAX_HIT_REGIONS 64
+#define MAX_TOUCH_BUTTONS 16
+#define HIT_BLOCK_EMPTY 0xff
+#define HIT_BLOCK_MIXED 0xfe
+
+typedef struct {
+    SDL_Rect area;
+    uint8_t kind;   // enum hitRegionKind
+    int8_t x, y;    // D-pad direction or button index
+} hit_region;
+
+// Everything the table depends on; it is rebuilt when any of these change
+typedef struct {
+    SDL_Rect display, dpad_area, left_panel_box, grid_box;
+    boolean dpad_shown;
+    int buttons_generation;
+} hit_layout;
+
+typedef struct {
+    SDL_Rect area;
+    signed long key;
+    boolean used;
+} touch_button;
+
+static hit_region hit_regions[MAX_HIT_REGIONS]; // highest priority first
+static int hit_region_count = 0;
+static uint8_t *hit_blocks = NULL;
+static int hit_blocks_w, hit_blocks_h;
+static hit_layout built_layout;
+static boolean hit_table_valid = false;
+
+static touch_button touch_buttons[MAX_TOUCH_BUTTONS];
+static int touch_buttons_generation = 0;
+
+static void current_hit_layout(hit_layout *layout) {
+    memset(layout, 0, sizeof(*layout));
+    layout->display = display;
+    layout->dpad_area = dpad_area;
+    layout->left_panel_box = left_panel_box;
+    layout->grid_box = grid_box;
+    layout->dpad_shown = game_started && dpad_enabled;
+    layout->buttons_generation = touch_buttons_generation;
+}
+
+static void add_hit_region(SDL_Rect area, uint8_t kind, int x, int y) {
+    if (hit_region_count < MAX_HIT_REGIONS && !SDL_RectEmpty(&area)) {
+        hit_regions[hit_region_count++] = (hit_region){.area = area, .kind = kind, .x = x, .y = y};
+    }
+}
+
+static void rebuild_hit_table(const hit_layout *layout) {
+    hit_region_count = 0;
+    for (int i = 0; i < MAX_TOUCH_BUTTONS; i++) {
+        if (touch_buttons[i].used) {
+            add_hit_region(touch_buttons[i].area, HIT_BUTTON, i, 0);
+        }
+    }
+    if (layout->dpad_shown) {
+        // 3x3 D-pad: the outer thirds are the directions, the centre confirms
+        const SDL_Rect *d = &layout->dpad_area;
+        int xs[4] = {d->x, d->x + d->w / 3, d->x + 2 * d->w / 3, d->x + d->w};
+        int ys[4] = {d->y, d->y + d->h / 3, d->y + 2 * d->h / 3, d->y + d->h};
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 3; col++) {
+                SDL_Rect area = {xs[col], ys[row], xs[col + 1] - xs[col], ys[row + 1] - ys[row]};
+                add_hit_region(area, HIT_DPAD, col - 1, row - 1);
+            }
+        }
+    }
+    add_hit_region(layout->grid_box, HIT_GRID, 0, 0);
+    add_hit_region(layout->left_panel_box, HIT_LEFT_PANEL, 0, 0);
+    add_hit_region((SDL_Rect){0, 0, layout->display.w, layout->display.h}, HIT_SCREEN, 0, 0);
+
+    int blocks_w = (layout->display.w + HIT_BLOCK - 1) >> HIT_BLOCK_SHIFT;
+    int blocks_h = (layout->display.h + HIT_BLOCK - 1) >> HIT_BLOCK_SHIFT;
+    if (blocks_w != hit_blocks_w || blocks_h != hit_blocks_h || hit_blocks == NULL) {
+        free(hit_blocks);
+        hit_blocks = malloc(max(1, blocks_w * blocks_h));
+        hit_blocks_w = blocks_w;
+        hit_blocks_h = blocks_h;
+    }
+    for (int by = 0; by < blocks_h; by++) {
+        for (int bx = 0; bx < blocks_w; bx++) {
+            SDL_Rect block = {bx << HIT_BLOCK_SHIFT, by << HIT_BLOCK_SHIFT, HIT_BLOCK, HIT_BLOCK};
+            uint8_t id = HIT_BLOCK_EMPTY;
+            for (int i = 0; i < hit_region_count; i++) {
+                SDL_Rect overlap;
+                if (SDL_IntersectRect(&block, &hit_regions[i].area, &overlap)) {
+                    id = (overlap.w == HIT_BLOCK && overlap.h == HIT_BLOCK) ? i : HIT_BLOCK_MIXED;
+                    break;
+                }
+            }
+            hit_blocks[by * blocks_w + bx] = id;
+        }
+    }
+    built_layout = *layout;
+    hit_table_valid = true;
+}
+
+hit_result hit_test(double x, double y) {
+    hit_layout layout;
+    current_hit_layout(&layout);
+    if (!hit_table_valid || memcmp(&layout, &built_layout, sizeof(layout)) != 0) {
+        rebuild_hit_table(&layout);
+    }
+
+    // Touches off the table still report the nearest cell, like the grid fallback always has,
+    // so a release on the screen edge doesn't send the cursor to 0,0
+    hit_result result = {.region = HIT_NONE};
+    int px = x, py = y;
+    int id = HIT_BLOCK_EMPTY;
+    if (px >= 0 && py >= 0 && (px >> HIT_BLOCK_SHIFT) < hit_blocks_w && (py >> HIT_BLOCK_SHIFT) < hit_blocks_h) {
+        id = hit_blocks[(py >> HIT_BLOCK_SHIFT) * hit_blocks_w + (px >> HIT_BLOCK_SHIFT)];
+    }
+    if (id == HIT_BLOCK_MIXED) {
+        SDL_Point p = {px, py};
+        for (id = 0; id < hit_region_count && !SDL_PointInRect(&p, &hit_regions[id].area); id++);
+        id = (id < hit_region_count) ? id : HIT_BLOCK_EMPTY;
+    }
+    if (id != HIT_BLOCK_EMPTY) {
+        result.region = hit_regions[id].kind;
+    }
+
+    switch (result.region) {
+    case HIT_DPAD:
+    case HIT_BUTTON:
+        result.x = hit_regions[id].x;
+        result.y = hit_regions[id].y;
+        break;
+    case HIT_GRID:
+        if (is_zoomed()) {
+            x = (x - grid_box.x) / zoom_level + grid_box_zoomed.x;
+            y = (y - grid_box.y) / zoom_level + grid_box_zoomed.y;
+        }
+        // fall through
+    default:
+        result.x = max(0, min(COLS - 1, x / cell_w));
+        result.y = max(0, min(ROWS - 1, y / cell_h));
+        break;
+    }
+    return result;
+}
+
+int add_touch_button(SDL_Rect area, signed long key) {
+    for (int i = 0; i < MAX_TOUCH_BUTTONS; i++) {
+        if (!touch_buttons[i].used) {
+            touch_buttons[i] = (touch_button){.area = area, .key = key, .used = true};
+            touch_buttons_generation++;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void remove_touch_button(int button) {
+    if (button >= 0 && button < MAX_TOUCH_BUTTONS && touch_buttons[button].used) {
+        touch_buttons[button].used = false;
+        touch_buttons_generation++;
+    }
+}
+
 boolean process_events() {
     static int16_t cursor_x = 0;
     static int16_t cursor_y = 0;
@@ -44,6 +282,7 @@ boolean process_events() {
     static uint32_t zoom_toggled_time = 0;
     static boolean virtual_keyboard = false;
     static boolean on_dpad = false;
+    static int pressed_button = -1;
     static bool_store prev_zoom_toggle = unset;
     static boolean in_left_panel = true;
     static SDL_FingerID primary_finger = -1;  // Track primary touch finger
@@ -53,11 +292,11 @@ boolean process_events() {
         return true;
     }
 
-    current_event.shiftKey = false;
-    current_event.controlKey = ctrl_pressed;
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         double raw_input_x, raw_input_y;
+        hit_result hit;
+        rogueEvent translated = {.eventType = EVENT_ERROR, .shiftKey = false, .controlKey = ctrl_pressed};
         switch (event.type) {
         case SDL_FINGERDOWN:
             num_fingers++;
@@ -71,7 +310,7 @@ boolean process_events() {
             } else if (num_fingers >= 3) {
                 // Third+ finger - ctrl modifier
                 if (!ctrl_pressed) {
-                    current_event.controlKey = ctrl_pressed = true;
+                    translated.controlKey = ctrl_pressed = true;
                     ctrl_time = SDL_GetTicks();
                 }
                 break;  // Don't overwrite existing events
@@ -84,24 +323,24 @@ boolean process_events() {
                 break;
             }
             on_dpad = false;
-            raw_input_x = event.tfinger.x * display.w;
-            raw_input_y = event.tfinger.y * display.h;
-            SDL_Point p = {.x = raw_input_x, .y = raw_input_y};
-            if (game_started && dpad_enabled && SDL_PointInRect(&p, &dpad_area)) {
+            pressed_button = -1;
+            hit = hit_test(event.tfinger.x * display.w, event.tfinger.y * display.h);
+            if (hit.region == HIT_DPAD) {
                 on_dpad = true;
                 finger_down_time = SDL_GetTicks();
                 break;
             }
-            if (is_zoomed() && SDL_PointInRect(&p, &grid_box)) {
-                raw_input_x = (raw_input_x - grid_box.x) / zoom_level + grid_box_zoomed.x;
-                raw_input_y = (raw_input_y - grid_box.y) / zoom_level + grid_box_zoomed.y;
+            if (hit.region == HIT_BUTTON) {
+                pressed_button = hit.x;
+                finger_down_time = SDL_GetTicks();
+                break;
             }
             if (!double_tap_lock || SDL_TICKS_PASSED(SDL_GetTicks(), finger_down_time + double_tap_interval)) {
-                cursor_x = min(COLS - 1, raw_input_x / cell_w);
-                cursor_y = min(ROWS - 1, raw_input_y / cell_h);
+                cursor_x = hit.x;
+                cursor_y = hit.y;
             }
             in_left_panel = false;
-            if (smart_zoom && left_panel_smart_zoom && SDL_PointInRect(&p, &left_panel_box) && cursor_x > LEFT_EDGE_WIDTH) {
+            if (smart_zoom && left_panel_smart_zoom && hit.region == HIT_LEFT_PANEL && cursor_x > LEFT_EDGE_WIDTH) {
                 if (cursor_y <= ROWS / 2) {  // Simplified sidebar check
                     in_left_panel = true;
                     if (prev_zoom_toggle == unset) {
@@ -110,9 +349,9 @@ boolean process_events() {
                 }
             }
 
-            current_event.param1 = cursor_x;
-            current_event.param2 = cursor_y;
-            current_event.eventType = MOUSE_DOWN;
+            translated.param1 = cursor_x;
+            translated.param2 = cursor_y;
+            translated.eventType = MOUSE_DOWN;
             finger_down_time = SDL_GetTicks();
             break;
 
@@ -135,93 +374,83 @@ boolean process_events() {
             if (!SDL_TICKS_PASSED(SDL_GetTicks(), zoom_changed_time + ZOOM_CHANGED_INTERVAL)) {
                 break;
             }
-            raw_input_x = event.tfinger.x * display.w;
-            raw_input_y = event.tfinger.y * display.h;
-            if (dpad_enabled && on_dpad) {
+            hit = hit_test(event.tfinger.x * display.w, event.tfinger.y * display.h);
+            if (pressed_button >= 0) {
+                if (hit.region == HIT_BUTTON && hit.x == pressed_button) {
+                    translated.eventType = KEYSTROKE;
+                    translated.param1 = touch_buttons[pressed_button].key;
+                }
+                pressed_button = -1;
+                break;
+            }
+            if (on_dpad) {
                 on_dpad = false;
                 if (finger_down_time == 0) {
                     break;
                 }
-                SDL_Point p = {.x = raw_input_x, .y = raw_input_y};
-                if (SDL_PointInRect(&p, &dpad_area)) {
-                    int diff_x = 0, diff_y = 0;
-                    SDL_Rect min_x = {.x = dpad_area.x, .y = dpad_area.y, .w = dpad_area.w / 3, .h = dpad_area.h};
-                    if (SDL_PointInRect(&p, &min_x)) {
-                        diff_x = -1;
-                    }
-                    SDL_Rect max_x = {.x = dpad_area.x + 2 * dpad_area.w / 3, .y = dpad_area.y, .w = dpad_area.w / 3, .h = dpad_area.h};
-                    if (SDL_PointInRect(&p, &max_x)) {
-                        diff_x = 1;
-                    }
-                    SDL_Rect min_y = {.x = dpad_area.x, .y = dpad_area.y, .w = dpad_area.w, .h = dpad_area.h / 3};
-                    if (SDL_PointInRect(&p, &min_y)) {
-                        diff_y = -1;
-                    }
-                    SDL_Rect max_y = {.x = dpad_area.x, .y = dpad_area.y + 2 * dpad_area.h / 3, .w = dpad_area.w, .h = dpad_area.h / 3};
-                    if (SDL_PointInRect(&p, &max_y)) {
-                        diff_y = 1;
-                    }
+                if (hit.region == HIT_DPAD) {
+                    int diff_x = hit.x, diff_y = hit.y;
                     if (dpad_mode) {
                         diff_y *= -1;
-                        current_event.eventType = KEYSTROKE;
+                        translated.eventType = KEYSTROKE;
                         if (diff_x < 0) {
                             if (diff_y < 0) {
-                                current_event.param1 = DOWNLEFT_KEY;
+                                translated.param1 = DOWNLEFT_KEY;
                             } else if (diff_y > 0) {
-                                current_event.param1 = UPLEFT_KEY;
+                                translated.param1 = UPLEFT_KEY;
                             } else {
-                                current_event.param1 = LEFT_KEY;
+                                translated.param1 = LEFT_KEY;
                             }
                         } else if (diff_x > 0) {
                             if (diff_y < 0) {
-                                current_event.param1 = DOWNRIGHT_KEY;
+                                translated.param1 = DOWNRIGHT_KEY;
                             } else if (diff_y > 0) {
-                                current_event.param1 = UPRIGHT_KEY;
+                                translated.param1 = UPRIGHT_KEY;
                             } else {
-                                current_event.param1 = RIGHT_KEY;
+                                translated.param1 = RIGHT_KEY;
                             }
                         } else if (diff_y < 0) {
-                            current_event.param1 = DOWN_KEY;
+                            translated.param1 = DOWN_KEY;
                         } else if (diff_y > 0) {
-                            current_event.param1 = UP_KEY;
+                            translated.param1 = UP_KEY;
                         } else if (rogue.playbackMode) {
-                            current_event.param1 = ACKNOWLEDGE_KEY;
+                            translated.param1 = ACKNOWLEDGE_KEY;
                         } else {
-                            current_event.param1 = RETURN_KEY;
+                            translated.param1 = RETURN_KEY;
                         }
                     } else {
                         cursor_x = max(LEFT_PANEL_WIDTH + 1, min(COLS - 1, cursor_x + diff_x));
                         cursor_y = max(TOP_LOG_HEIGIHT, min(ROWS - (BOTTOM_BUTTONS_HEIGHT + 1), cursor_y + diff_y));
-                        current_event.param1 = cursor_x;
-                        current_event.param2 = cursor_y;
-                        current_event.eventType = MOUSE_ENTERED_CELL;
+                        translated.param1 = cursor_x;
+                        translated.param2 = cursor_y;
+                        translated.eventType = MOUSE_ENTERED_CELL;
                         if (!diff_x && !diff_y) {
-                            current_event.eventType = MOUSE_UP;
+                            translated.eventType = MOUSE_UP;
                         }
                     }
                     break;
                 }
             }
             virtual_keyboard = false;
-            current_event.param1 = cursor_x;
-            current_event.param2 = cursor_y;
-            if (current_event.param1 < LEFT_EDGE_WIDTH) {
-                if (current_event.param2 < 2) {
-                    current_event.eventType = KEYSTROKE;
+            translated.param1 = cursor_x;
+            translated.param2 = cursor_y;
+            if (translated.param1 < LEFT_EDGE_WIDTH) {
+                if (translated.param2 < 2) {
+                    translated.eventType = KEYSTROKE;
                     if (rogue.playbackMode) {
-                        current_event.param1 = ACKNOWLEDGE_KEY;
+                        translated.param1 = ACKNOWLEDGE_KEY;
                     } else {
-                        current_event.param1 = '\012';  // ENTER_KEY
+                        translated.param1 = '\012';  // ENTER_KEY
                     }
-                } else if (current_event.param2 > (ROWS - 3)) {
-                    current_event.eventType = KEYSTROKE;
-                    current_event.param1 = ESCAPE_KEY;
+                } else if (translated.param2 > (ROWS - 3)) {
+                    translated.eventType = KEYSTROKE;
+                    translated.param1 = ESCAPE_KEY;
                 } else {
                     virtual_keyboard = true;
                     start_text_input();
                 }
             } else {
-                current_event.eventType = MOUSE_UP;
+                translated.eventType = MOUSE_UP;
             }
             if (!virtual_keyboard) {
                 stop_text_input();
@@ -230,7 +459,10 @@ boolean process_events() {
 
         case SDL_FINGERMOTION:
             if (!SDL_TICKS_PASSED(SDL_GetTicks(), zoom_changed_time + ZOOM_CHANGED_INTERVAL)) {
-                current_event.eventType = EVENT_ERROR;
+                // a pinch is still settling; drop the touch that started it
+                if (has_staged && staged.event.eventType == MOUSE_DOWN) {
+                    has_staged = false;
+                }
                 break;
             }
             if (finger_down_time != 0 && SDL_TICKS_PASSED(SDL_GetTicks(), finger_down_time + long_press_interval)) {
@@ -262,9 +494,9 @@ boolean process_events() {
             raw_input_y = event.button.y * display_scale;
             cursor_x = min(COLS - 1, raw_input_x / cell_w);
             cursor_y = min(ROWS - 1, raw_input_y / cell_h);
-            current_event.param1 = cursor_x;
-            current_event.param2 = cursor_y;
-            current_event.eventType = MOUSE_DOWN;
+            translated.param1 = cursor_x;
+            translated.param2 = cursor_y;
+            translated.eventType = MOUSE_DOWN;
             break;
 
         case SDL_MOUSEBUTTONUP:
@@ -273,73 +505,73 @@ boolean process_events() {
             raw_input_y = event.button.y * display_scale;
             cursor_x = min(COLS - 1, raw_input_x / cell_w);
             cursor_y = min(ROWS - 1, raw_input_y / cell_h);
-            current_event.param1 = cursor_x;
-            current_event.param2 = cursor_y;
+            translated.param1 = cursor_x;
+            translated.param2 = cursor_y;
             if (cursor_x < LEFT_EDGE_WIDTH) {
                 if (cursor_y < 2) {
-                    current_event.eventType = KEYSTROKE;
+                    translated.eventType = KEYSTROKE;
                     if (rogue.playbackMode) {
-                        current_event.param1 = ACKNOWLEDGE_KEY;
+                        translated.param1 = ACKNOWLEDGE_KEY;
                     } else {
-                        current_event.param1 = '\012';  // ENTER_KEY
+                        translated.param1 = '\012';  // ENTER_KEY
                     }
                 } else if (cursor_y > (ROWS - 3)) {
-                    current_event.eventType = KEYSTROKE;
-                    current_event.param1 = ESCAPE_KEY;
+                    translated.eventType = KEYSTROKE;
+                    translated.param1 = ESCAPE_KEY;
                 } else {
                     start_text_input();
                 }
             } else {
-                current_event.eventType = MOUSE_UP;
+                translated.eventType = MOUSE_UP;
             }
             break;
 
         case SDL_KEYDOWN:
-            current_event.eventType = KEYSTROKE;
+            translated.eventType = KEYSTROKE;
             SDL_KeyCode k = event.key.keysym.sym;
             if (event.key.keysym.mod & KMOD_CTRL) {
-                current_event.controlKey = ctrl_pressed = true;
+                translated.controlKey = ctrl_pressed = true;
                 ctrl_time = SDL_GetTicks();
             }
             switch (k) {
             case SDLK_ESCAPE:
-                current_event.param1 = ESCAPE_KEY;
+                translated.param1 = ESCAPE_KEY;
                 break;
             case SDLK_BACKSPACE:
             case SDLK_DELETE:
-                current_event.param1 = DELETE_KEY;
+                translated.param1 = DELETE_KEY;
                 break;
             case SDLK_LEFT:
-                current_event.param1 = LEFT_KEY;
+                translated.param1 = LEFT_KEY;
                 break;
             case SDLK_RIGHT:
-                current_event.param1 = RIGHT_KEY;
+                translated.param1 = RIGHT_KEY;
                 break;
             case SDLK_UP:
-                current_event.param1 = UP_KEY;
+                translated.param1 = UP_KEY;
                 break;
             case SDLK_DOWN:
-                current_event.param1 = DOWN_KEY;
+                translated.param1 = DOWN_KEY;
                 break;
             case SDLK_SPACE:
-                current_event.param1 = ACKNOWLEDGE_KEY;
+                translated.param1 = ACKNOWLEDGE_KEY;
                 break;
             case SDLK_RETURN:
-                current_event.param1 = RETURN_KEY;
+                translated.param1 = RETURN_KEY;
                 break;
             case SDLK_TAB:
-                current_event.param1 = TAB_KEY;
+                translated.param1 = TAB_KEY;
                 break;
             default:
                 if (event.key.keysym.mod & (KMOD_SHIFT | KMOD_CAPS)) {
                     if ('a' <= k && k <= 'z') {
                         k += 'A' - 'a';
-                        current_event.shiftKey = true;
+                        translated.shiftKey = true;
                     } else {
                         k += '?' - '/';
                     }
                 }
-                current_event.param1 = k;
+                translated.param1 = k;
                 break;
             }
             break;
@@ -353,10 +585,14 @@ boolean process_events() {
             screen_changed = true;
             break;
         }
+        if (translated.eventType != EVENT_ERROR) {
+            emit_event(&translated, event.common.timestamp);
+        }
     }
+    flush_staged();
 
     if (SDL_TICKS_PASSED(SDL_GetTicks(), ctrl_time + 1000)) {
-        current_event.controlKey = ctrl_pressed = false;
+        ctrl_pressed = false;
     }
 
     boolean dialog_popup = !smart_zoom_allowed();
@@ -369,5 +605,34 @@ boolean process_events() {
         zoom_toggle = prev_zoom_toggle == set_true ? true : false;
         prev_zoom_toggle = unset;
     }
+    queued_event next;
+    if (queue_pop(&next)) {
+        current_event = next.event;
+        // the game acts on it now; latency runs until the frame showing the result is presented
+        if (!awaiting_present || SDL_TICKS_PASSED(awaiting_present_since, next.timestamp)) {
+            awaiting_present_since = next.timestamp;
+        }
+        awaiting_present = true;
+    }
     return current_event.eventType != EVENT_ERROR;
 }
+
+void input_frame_presented() {
+    if (!awaiting_present) {
+        return;
+    }
+    awaiting_present = false;
+    uint32_t latency = SDL_GetTicks() - awaiting_present_since;
+    int bucket = 0;
+    while (bucket < INPUT_LATENCY_BUCKETS - 1 && latency >= (1u << bucket)) {
+        bucket++;
+    }
+    latency_histogram.buckets[bucket]++;
+    latency_histogram.samples++;
+    latency_histogram.total_ms += latency;
+    latency_histogram.max_ms = max(latency_histogram.max_ms, latency);
+}
+
+const input_latency_histogram *get_input_latency_histogram() {
+    return &latency_histogram;
+}
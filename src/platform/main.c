@@ -18,6 +18,7 @@
 
 #define MAX_ERROR_LENGTH 200
 #define FRAME_INTERVAL 50
+#define SETTINGS_POLL_INTERVAL 1000
 
 struct brogueConsole currentConsole;
 
@@ -45,6 +46,8 @@ void destroy_assets() {
     SDL_SetRenderTarget(renderer, NULL);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
+    // destroyed along with the renderer
+    screen_texture = dpad_image_select = dpad_image_move = NULL;
 }
 
 void general_error(boolean critical, const char *error_title, const char *error_message, ...) {
@@ -65,6 +68,47 @@ void general_error(boolean critical, const char *error_title, const char *error_
 
 #define invalid_config_error(error_title, ...) general_error(true, error_title, __VA_ARGS__)
 
+static void destroy_dpad() {
+    if (dpad_image_select) {
+        SDL_DestroyTexture(dpad_image_select);
+        SDL_DestroyTexture(dpad_image_move);
+        dpad_image_select = dpad_image_move = NULL;
+    }
+}
+
+static void create_dpad() {
+    destroy_dpad();
+    if (dpad_enabled) {
+        // Create D-pad textures programmatically (no BMP needed)
+        SDL_Surface *dpad_surface = SDL_CreateRGBSurface(0, 128, 128, 32, 0, 0, 0, 0);
+        SDL_FillRect(dpad_surface, NULL, SDL_MapRGB(dpad_surface->format, 128, 128, 128));
+
+        // Draw D-pad pattern
+        SDL_Rect center = {42, 42, 44, 44};
+        SDL_FillRect(dpad_surface, &center, SDL_MapRGB(dpad_surface->format, 200, 200, 200));
+        SDL_Rect up = {42, 0, 44, 42};
+        SDL_FillRect(dpad_surface, &up, SDL_MapRGB(dpad_surface->format, 180, 180, 180));
+        SDL_Rect down = {42, 86, 44, 42};
+        SDL_FillRect(dpad_surface, &down, SDL_MapRGB(dpad_surface->format, 180, 180, 180));
+        SDL_Rect left = {0, 42, 42, 44};
+        SDL_FillRect(dpad_surface, &left, SDL_MapRGB(dpad_surface->format, 180, 180, 180));
+        SDL_Rect right = {86, 42, 42, 44};
+        SDL_FillRect(dpad_surface, &right, SDL_MapRGB(dpad_surface->format, 180, 180, 180));
+
+        dpad_image_select = SDL_CreateTextureFromSurface(renderer, dpad_surface);
+        SDL_SetTextureAlphaMod(dpad_image_select, dpad_transparency);
+        dpad_image_move = SDL_CreateTextureFromSurface(renderer, dpad_surface);
+        SDL_SetTextureColorMod(dpad_image_move, COLOR_MAX, COLOR_MAX, 155);
+        SDL_SetTextureAlphaMod(dpad_image_move, dpad_transparency);
+        SDL_FreeSurface(dpad_surface);
+
+        double area_width = min(cell_w * (LEFT_PANEL_WIDTH - 4), cell_h * 20);
+        dpad_area.h = dpad_area.w = (dpad_width) ? dpad_width : area_width;
+        dpad_area.x = (dpad_x_pos) ? dpad_x_pos : 3 * cell_w;
+        dpad_area.y = (dpad_y_pos) ? dpad_y_pos : (display.h - (area_width + 2 * cell_h));
+    }
+}
+
 void create_assets() {
     if (SDL_CreateWindowAndRenderer(display.w, display.h,
                                     SDL_WINDOW_FULLSCREEN | SDL_WINDOW_ALLOW_HIGHDPI,
@@ -104,35 +148,7 @@ void create_assets() {
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, COLOR_MAX);
     SDL_RenderClear(renderer);
 
-    if (dpad_enabled) {
-        // Create D-pad textures programmatically (no BMP needed)
-        SDL_Surface *dpad_surface = SDL_CreateRGBSurface(0, 128, 128, 32, 0, 0, 0, 0);
-        SDL_FillRect(dpad_surface, NULL, SDL_MapRGB(dpad_surface->format, 128, 128, 128));
-
-        // Draw D-pad pattern
-        SDL_Rect center = {42, 42, 44, 44};
-        SDL_FillRect(dpad_surface, &center, SDL_MapRGB(dpad_surface->format, 200, 200, 200));
-        SDL_Rect up = {42, 0, 44, 42};
-        SDL_FillRect(dpad_surface, &up, SDL_MapRGB(dpad_surface->format, 180, 180, 180));
-        SDL_Rect down = {42, 86, 44, 42};
-        SDL_FillRect(dpad_surface, &down, SDL_MapRGB(dpad_surface->format, 180, 180, 180));
-        SDL_Rect left = {0, 42, 42, 44};
-        SDL_FillRect(dpad_surface, &left, SDL_MapRGB(dpad_surface->format, 180, 180, 180));
-        SDL_Rect right = {86, 42, 42, 44};
-        SDL_FillRect(dpad_surface, &right, SDL_MapRGB(dpad_surface->format, 180, 180, 180));
-
-        dpad_image_select = SDL_CreateTextureFromSurface(renderer, dpad_surface);
-        SDL_SetTextureAlphaMod(dpad_image_select, dpad_transparency);
-        dpad_image_move = SDL_CreateTextureFromSurface(renderer, dpad_surface);
-        SDL_SetTextureColorMod(dpad_image_move, COLOR_MAX, COLOR_MAX, 155);
-        SDL_SetTextureAlphaMod(dpad_image_move, dpad_transparency);
-        SDL_FreeSurface(dpad_surface);
-
-        double area_width = min(cell_w * (LEFT_PANEL_WIDTH - 4), cell_h * 20);
-        dpad_area.h = dpad_area.w = (dpad_width) ? dpad_width : area_width;
-        dpad_area.x = (dpad_x_pos) ? dpad_x_pos : 3 * cell_w;
-        dpad_area.y = (dpad_y_pos) ? dpad_y_pos : (display.h - (area_width + 2 * cell_h));
-    }
+    create_dpad();
 
     if (keyboard_visibility == 2) {
         start_text_input();
@@ -156,54 +172,65 @@ int suspend_resume_filter(void *userdata, SDL_Event *event) {
     return 1;
 }
 
+// Texture filtering for textures created from now on; filter_mode uses the hint's values
+static void set_filter_hint() {
+    char render_hint[2] = {filter_mode + '0', 0};
+    SDL_SetHintWithPriority(SDL_HINT_RENDER_SCALE_QUALITY, render_hint, SDL_HINT_OVERRIDE);
+}
+
+// Picks the display size, orientation, texture filtering and cell size from the settings
+static void setup_display() {
+    display = screen;
+    if (force_portrait) {
+        SDL_SetHintWithPriority(SDL_HINT_ORIENTATIONS, "Portrait PortraitUpsideDown", SDL_HINT_OVERRIDE);
+        // Swap if needed to get portrait
+        if (display.w > display.h) {
+            int tmp = display.w;
+            display.w = display.h;
+            display.h = tmp;
+        }
+    } else {
+        SDL_SetHintWithPriority(SDL_HINT_ORIENTATIONS, "LandscapeLeft LandscapeRight", SDL_HINT_OVERRIDE);
+        // Swap if needed to get landscape (iOS reports portrait by default)
+        if (display.w < display.h) {
+            int tmp = display.w;
+            display.w = display.h;
+            display.h = tmp;
+        }
+    }
+    set_filter_hint();
+
+    if (custom_cell_width != 0) {
+        cell_w = custom_cell_width;
+    } else {
+        cell_w = ((double)display.w) / COLS;
+    }
+    if (custom_cell_height != 0) {
+        cell_h = custom_cell_height;
+    } else {
+        cell_h = ((double)display.h) / ROWS;
+    }
+
+    left_panel_box = (SDL_Rect){.x = 0, .y = 0, .w = LEFT_PANEL_WIDTH * cell_w, .h = ROWS * cell_h};
+    log_panel_box = (SDL_Rect){.x = LEFT_PANEL_WIDTH * cell_w, .y = 0,
+                               .w = (COLS - LEFT_PANEL_WIDTH) * cell_w, .h = TOP_LOG_HEIGIHT * cell_h};
+    button_panel_box = (SDL_Rect){.x = LEFT_PANEL_WIDTH * cell_w,
+                                  .y = (ROWS - BOTTOM_BUTTONS_HEIGHT) * cell_h,
+                                  .w = (COLS - LEFT_PANEL_WIDTH) * cell_w,
+                                  .h = BOTTOM_BUTTONS_HEIGHT * cell_h};
+    grid_box = grid_box_zoomed = (SDL_Rect){.x = LEFT_PANEL_WIDTH * cell_w,
+                                            .y = TOP_LOG_HEIGIHT * cell_h,
+                                            .w = (COLS - LEFT_PANEL_WIDTH) * cell_w,
+                                            .h = (ROWS - TOP_LOG_HEIGIHT - BOTTOM_BUTTONS_HEIGHT) * cell_h};
+}
+
 void TouchScreenGameLoop() {
     restart_game = true;
     settings_changed = false;
     do {
         if (restart_game) {
-            display = screen;
-            if (force_portrait) {
-                SDL_SetHintWithPriority(SDL_HINT_ORIENTATIONS, "Portrait PortraitUpsideDown", SDL_HINT_OVERRIDE);
-                // Swap if needed to get portrait
-                if (display.w > display.h) {
-                    int tmp = display.w;
-                    display.w = display.h;
-                    display.h = tmp;
-                }
-            } else {
-                SDL_SetHintWithPriority(SDL_HINT_ORIENTATIONS, "LandscapeLeft LandscapeRight", SDL_HINT_OVERRIDE);
-                // Swap if needed to get landscape (iOS reports portrait by default)
-                if (display.w < display.h) {
-                    int tmp = display.w;
-                    display.w = display.h;
-                    display.h = tmp;
-                }
-            }
-            char render_hint[2] = {filter_mode + '0', 0};
-            SDL_SetHintWithPriority(SDL_HINT_RENDER_SCALE_QUALITY, render_hint, SDL_HINT_OVERRIDE);
-
-            if (custom_cell_width != 0) {
-                cell_w = custom_cell_width;
-            } else {
-                cell_w = ((double)display.w) / COLS;
-            }
-            if (custom_cell_height != 0) {
-                cell_h = custom_cell_height;
-            } else {
-                cell_h = ((double)display.h) / ROWS;
-            }
-
-            left_panel_box = (SDL_Rect){.x = 0, .y = 0, .w = LEFT_PANEL_WIDTH * cell_w, .h = ROWS * cell_h};
-            log_panel_box = (SDL_Rect){.x = LEFT_PANEL_WIDTH * cell_w, .y = 0,
-                                       .w = (COLS - LEFT_PANEL_WIDTH) * cell_w, .h = TOP_LOG_HEIGIHT * cell_h};
-            button_panel_box = (SDL_Rect){.x = LEFT_PANEL_WIDTH * cell_w,
-                                          .y = (ROWS - BOTTOM_BUTTONS_HEIGHT) * cell_h,
-                                          .w = (COLS - LEFT_PANEL_WIDTH) * cell_w,
-                                          .h = BOTTOM_BUTTONS_HEIGHT * cell_h};
-            grid_box = grid_box_zoomed = (SDL_Rect){.x = LEFT_PANEL_WIDTH * cell_w,
-                                                    .y = TOP_LOG_HEIGIHT * cell_h,
-                                                    .w = (COLS - LEFT_PANEL_WIDTH) * cell_w,
-                                                    .h = (ROWS - TOP_LOG_HEIGIHT - BOTTOM_BUTTONS_HEIGHT) * cell_h};
+            settings_invalidated = INVALIDATES_NOTHING;
+            setup_display();
             create_assets();
             if (!init_font()) {
                 invalid_config_error("Font Error",
@@ -232,6 +259,42 @@ boolean resume() {
     return false;
 }
 
+// Applies settings changed since the last call (including edits to the settings file, checked
+// every SETTINGS_POLL_INTERVAL), rebuilding only what they invalidate
+static void apply_settings_changes() {
+    static uint32_t last_poll = 0;
+    if (SDL_TICKS_PASSED(SDL_GetTicks(), last_poll + SETTINGS_POLL_INTERVAL)) {
+        last_poll = SDL_GetTicks();
+        reload_conf_if_changed();
+    }
+    int invalidated = settings_invalidated;
+    settings_invalidated = INVALIDATES_NOTHING;
+
+    if (invalidated & INVALIDATES_RENDERER) {
+        destroy_assets();
+        destroy_font();
+        setup_display();
+        create_assets();
+        if (!init_font()) {
+            invalid_config_error("Font Error",
+                                 "Resolution/cell size is too small for minimum allowed font size");
+        }
+        refreshScreen();
+        return;
+    }
+    if (invalidated & INVALIDATES_GLYPHS) {
+        set_filter_hint();
+        SDL_SetTextureScaleMode(screen_texture, (SDL_ScaleMode)filter_mode);
+        reset_glyph_cache();
+    }
+    if (invalidated & INVALIDATES_LAYOUT) {
+        create_dpad();
+    }
+    if (invalidated != INVALIDATES_NOTHING) {
+        refreshScreen();
+    }
+}
+
 boolean TouchScreenPauseForMilliseconds(short milliseconds, PauseBehavior behavior) {
     (void)behavior;  // Unused for now
     uint32_t init_time = SDL_GetTicks();
@@ -241,6 +304,7 @@ boolean TouchScreenPauseForMilliseconds(short milliseconds, PauseBehavior behavi
         SDL_Delay(milliseconds - epoch);
     }
     resume();
+    apply_settings_changes();
     return process_events();
 }
 
@@ -399,6 +463,10 @@ int main(int argc, char *argv[]) {
     }
 
     SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+#ifdef SDL_HINT_RENDER_SHARE_SURFACE_PIXELS
+    // Tile, glyph and d-pad surfaces are freed untouched once their textures exist
+    SDL_SetHint(SDL_HINT_RENDER_SHARE_SURFACE_PIXELS, "1");
+#endif
     // Disable synthetic touch events from mouse - handle mouse directly
     SDL_SetHint(SDL_HINT_MOUSE_TOUCH_EVENTS, "0");
     SDL_SetEventFilter(suspend_resume_filter, NULL);
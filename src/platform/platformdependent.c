@@ -27,198 +27,191 @@
 #include <time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "platform.h"
 #include "GlobalsBase.h"
 
 typedef struct brogueScoreEntry {
     long int score;
-    long int dateNumber; // in seconds
-    char dateText[COLS]; // in the form mm/dd/yy
+    long int dateNumber; // in seconds (formatted only when the list is displayed)
     char description[COLS];
 } brogueScoreEntry;
 
 brogueScoreEntry scoreBuffer[HIGH_SCORES_COUNT];
 
+// One record per glyph from G_UP_ARROW on, in enum order, so that both the text consoles and
+// the SDL renderer can resolve a glyph with a single indexed load.
+// fontKey is the glyph to draw from the bundled font in text, tile and alternate tile mode; glyphs
+// with no tile art use their text glyph in every mode.
+#define TILE_GLYPH(glyph, unicode, ascii, tile, environment) \
+    [glyph - G_UP_ARROW] = {unicode, {ascii, tile, tile + GLYPH_TILE_FRAME_OFFSET}, environment}
+#define TEXT_GLYPH(glyph, unicode, ascii, environment) \
+    [glyph - G_UP_ARROW] = {unicode, {ascii, ascii, ascii}, environment}
+
+glyphInfo glyphTable[GLYPH_TABLE_SIZE] = {
+    TEXT_GLYPH(G_UP_ARROW, U_UP_ARROW, 128 + 8, true),
+    TEXT_GLYPH(G_DOWN_ARROW, U_DOWN_ARROW, 144 + 1, true),
+    TILE_GLYPH(G_POTION, '!', '!', 262, false),
+    TILE_GLYPH(G_GRASS, '"', '"', 339, true),
+    TILE_GLYPH(G_WALL, '#', '#', 348, true),
+    TEXT_GLYPH(G_DEMON, '&', '&', false),
+    TILE_GLYPH(G_OPEN_DOOR, '\'', '\'', 354, true),
+    TILE_GLYPH(G_GOLD, '*', '*', 259, false),
+    TILE_GLYPH(G_CLOSED_DOOR, '+', '+', 355, true),
+    TILE_GLYPH(G_RUBBLE, ',', ',', 334, true),
+    TILE_GLYPH(G_KEY, '-', '-', 364, false),
+    TILE_GLYPH(G_BOG, '~', ',', 337, true),
+    TILE_GLYPH(G_CHAIN_TOP_LEFT, '\\', '\\', 391, true),
+    TILE_GLYPH(G_CHAIN_BOTTOM_RIGHT, '\\', '\\', 395, true),
+    TILE_GLYPH(G_CHAIN_TOP_RIGHT, '/', '/', 396, true),
+    TILE_GLYPH(G_CHAIN_BOTTOM_LEFT, '/', '/', 392, true),
+    TILE_GLYPH(G_CHAIN_TOP, '|', '|', 390, true),
+    TILE_GLYPH(G_CHAIN_BOTTOM, '|', '|', 394, true),
+    TILE_GLYPH(G_CHAIN_LEFT, '-', '-', 389, true),
+    TILE_GLYPH(G_CHAIN_RIGHT, '-', '-', 393, true),
+    TILE_GLYPH(G_FOOD, ';', ';', 258, false),
+    TILE_GLYPH(G_UP_STAIRS, '<', '<', 360, true),
+    TILE_GLYPH(G_VENT, '=', '=', 381, true),
+    TILE_GLYPH(G_DOWN_STAIRS, '>', '>', 361, true),
+    TILE_GLYPH(G_PLAYER, '@', '@', 256, false),
+    TILE_GLYPH(G_BOG_MONSTER, 'B', 'B', 271, false),
+    TILE_GLYPH(G_CENTAUR, 'C', 'C', 272, false),
+    TILE_GLYPH(G_DRAGON, 'D', 'D', 277, false),
+    TILE_GLYPH(G_FLAMEDANCER, 'F', 'F', 280, false),
+    TILE_GLYPH(G_GOLEM, 'G', 'G', 285, false),
+    TILE_GLYPH(G_TENTACLE_HORROR, 'H', 'H', 306, false),
+    TILE_GLYPH(G_IFRIT, 'I', 'I', 287, false),
+    TILE_GLYPH(G_JELLY, 'J', 'J', 290, false),
+    TILE_GLYPH(G_KRAKEN, 'K', 'K', 292, false),
+    TILE_GLYPH(G_LICH, 'L', 'L', 293, false),
+    TILE_GLYPH(G_NAGA, 'N', 'N', 296, false),
+    TILE_GLYPH(G_OGRE, 'O', 'O', 297, false),
+    TILE_GLYPH(G_PHANTOM, 'P', 'P', 299, false),
+    TILE_GLYPH(G_REVENANT, 'R', 'R', 303, false),
+    TILE_GLYPH(G_SALAMANDER, 'S', 'S', 304, false),
+    TILE_GLYPH(G_TROLL, 'T', 'T', 309, false),
+    TILE_GLYPH(G_UNDERWORM, 'U', 'U', 311, false),
+    TILE_GLYPH(G_VAMPIRE, 'V', 'V', 313, false),
+    TILE_GLYPH(G_WRAITH, 'W', 'W', 317, false),
+    TILE_GLYPH(G_ZOMBIE, 'Z', 'Z', 318, false),
+    TILE_GLYPH(G_ARMOR, '[', '[', 260, false),
+    TILE_GLYPH(G_STAFF, '/', '\\', 265, false),
+    TILE_GLYPH(G_WEB, ':', ':', 382, true),
+    TILE_GLYPH(G_MOUND, 'a', 'a', 295, false),
+    TILE_GLYPH(G_BLOAT, 'b', 'b', 270, false),
+    TILE_GLYPH(G_CENTIPEDE, 'c', 'c', 273, false),
+    TILE_GLYPH(G_DAR_BLADEMASTER, 'd', 'd', 275, false),
+    TILE_GLYPH(G_EEL, 'e', 'e', 278, false),
+    TILE_GLYPH(G_FURY, 'f', 'f', 281, false),
+    TILE_GLYPH(G_GOBLIN, 'g', 'g', 282, false),
+    TILE_GLYPH(G_IMP, 'i', 'i', 288, false),
+    TILE_GLYPH(G_JACKAL, 'j', 'j', 289, false),
+    TILE_GLYPH(G_KOBOLD, 'k', 'k', 291, false),
+    TILE_GLYPH(G_MONKEY, 'm', 'm', 294, false),
+    TILE_GLYPH(G_PIXIE, 'p', 'p', 301, false),
+    TILE_GLYPH(G_RAT, 'r', 'r', 302, false),
+    TILE_GLYPH(G_SPIDER, 's', 's', 305, false),
+    TILE_GLYPH(G_TOAD, 't', 't', 307, false),
+    TILE_GLYPH(G_BAT, 'v', 'v', 269, false),
+    TILE_GLYPH(G_WISP, 'w', 'w', 316, false),
+    TILE_GLYPH(G_PHOENIX, 'P', 'P', 300, false),
+    TILE_GLYPH(G_ALTAR, '|', '|', 368, true),
+    TILE_GLYPH(G_LIQUID, '~', '~', 327, true),
+    TILE_GLYPH(G_FLOOR, U_MIDDLE_DOT, '.', 325, true),
+    TILE_GLYPH(G_CHASM, U_FOUR_DOTS, 128 + 1, 328, true),
+    TILE_GLYPH(G_TRAP, U_DIAMOND, 128 + 2, 371, true),
+    TILE_GLYPH(G_FIRE, U_FLIPPED_V, 128 + 3, 330, true),
+    TILE_GLYPH(G_FOLIAGE, U_ARIES, 128 + 4, 340, true),
+    TILE_GLYPH(G_AMULET, U_ANKH, 128 + 5, 323, false),
+    TILE_GLYPH(G_SCROLL, U_MUSIC_NOTE, 128 + 6, 263, false),
+    TILE_GLYPH(G_RING, U_CIRCLE, 128 + 7, 264, false),
+    TILE_GLYPH(G_WEAPON, U_UP_ARROW, 128 + 8, 261, false),
+    TILE_GLYPH(G_GEM, U_FILLED_CIRCLE, 128 + 9, 385, false),
+    TILE_GLYPH(G_TOTEM, U_NEUTER, 128 + 10, 308, true),
+    TILE_GLYPH(G_GOOD_MAGIC, U_FILLED_CIRCLE_BARS, 128 + 13, 319, true),
+    TILE_GLYPH(G_BAD_MAGIC, U_CIRCLE_BARS, 128 + 12, 321, true),
+    TILE_GLYPH(G_DOORWAY, U_OMEGA, 144 + 6, 359, true),
+    TILE_GLYPH(G_CHARM, U_LIGHTNING_BOLT, 144 + 9, 267, false),
+    TILE_GLYPH(G_WALL_TOP, '#', '#', 349, true),
+    TILE_GLYPH(G_DAR_PRIESTESS, 'd', 'd', 276, false),
+    TILE_GLYPH(G_DAR_BATTLEMAGE, 'd', 'd', 274, false),
+    TILE_GLYPH(G_GOBLIN_MAGIC, 'g', 'g', 284, false),
+    TILE_GLYPH(G_GOBLIN_CHIEFTAN, 'g', 'g', 283, false),
+    TILE_GLYPH(G_OGRE_MAGIC, 'O', 'O', 298, false),
+    TILE_GLYPH(G_GUARDIAN, U_ESZETT, 223, 286, false),
+    TILE_GLYPH(G_WINGED_GUARDIAN, U_ESZETT, 223, 315, false),
+    TILE_GLYPH(G_EGG, U_FILLED_CIRCLE, 128 + 9, 279, false),
+    TILE_GLYPH(G_WARDEN, 'Y', 'Y', 314, false),
+    TILE_GLYPH(G_DEWAR, '&', '&', 365, false),
+    TILE_GLYPH(G_ANCIENT_SPIRIT, 'M', 'M', 268, false),
+    TILE_GLYPH(G_LEVER, '/', '/', 369, true),
+    TILE_GLYPH(G_LEVER_PULLED, '\\', '\\', 370, true),
+    TILE_GLYPH(G_BLOODWORT_STALK, U_ARIES, 128 + 4, 341, true),
+    TILE_GLYPH(G_FLOOR_ALT, U_MIDDLE_DOT, '.', 326, true),
+    TILE_GLYPH(G_UNICORN, U_U_ACUTE, 218, 312, false),
+    TILE_GLYPH(G_TURRET, U_FILLED_CIRCLE, 128 + 9, 310, true),
+    TILE_GLYPH(G_WAND, '~', '~', 266, false),
+    TILE_GLYPH(G_GRANITE, '#', '#', 350, true),
+    TILE_GLYPH(G_CARPET, U_MIDDLE_DOT, '.', 336, true),
+    TILE_GLYPH(G_CLOSED_IRON_DOOR, '+', '+', 357, true),
+    TILE_GLYPH(G_OPEN_IRON_DOOR, '\'', '\'', 356, true),
+    TILE_GLYPH(G_TORCH, '#', '#', 331, true),
+    TILE_GLYPH(G_CRYSTAL, '#', '#', 352, true),
+    TILE_GLYPH(G_PORTCULLIS, '#', '#', 358, true),
+    TILE_GLYPH(G_BARRICADE, '#', '#', 363, true),
+    TILE_GLYPH(G_STATUE, U_ESZETT, 223, 346, true),
+    TILE_GLYPH(G_CRACKED_STATUE, U_ESZETT, 223, 347, true),
+    TILE_GLYPH(G_CLOSED_CAGE, '#', '#', 366, true),
+    TILE_GLYPH(G_OPEN_CAGE, '|', '|', 367, true),
+    TILE_GLYPH(G_PEDESTAL, '|', '|', 386, true),
+    TILE_GLYPH(G_CLOSED_COFFIN, '-', '|', 387, true),
+    TILE_GLYPH(G_OPEN_COFFIN, '-', '|', 388, true),
+    TILE_GLYPH(G_MAGIC_GLYPH, U_FOUR_DOTS, 128 + 1, 345, true),
+    TILE_GLYPH(G_BRIDGE, '=', '=', 362, true),
+    TILE_GLYPH(G_BONES, ',', ',', 335, true),
+    TILE_GLYPH(G_ELECTRIC_CRYSTAL, U_CURRENCY, 164, 353, true),
+    TILE_GLYPH(G_ASHES, '\'', '\'', 333, true),
+    TILE_GLYPH(G_BEDROLL, '=', '=', 338, false),
+    TILE_GLYPH(G_BLOODWORT_POD, '*', '*', 342, false),
+    TILE_GLYPH(G_VINE, ':', ':', 384, true),
+    TILE_GLYPH(G_NET, ':', ':', 383, true),
+    TILE_GLYPH(G_LICHEN, '"', '"', 339, true),
+    TEXT_GLYPH(G_PIPES, '+', '+', true),
+    TILE_GLYPH(G_SAC_ALTAR, '|', '|', 368, true),
+    TILE_GLYPH(G_ORB_ALTAR, '|', '|', 368, true),
+    TEXT_GLYPH(G_LEFT_TRIANGLE, U_LEFT_TRIANGLE, '<', false),
+};
+
+#undef TILE_GLYPH
+#undef TEXT_GLYPH
+
+// glyphToUnicode passes every glyph below the table through as ASCII, and an entry past
+// GLYPH_TABLE_LAST fails to compile, so these are all the table relies on
+_Static_assert(G_UP_ARROW == 128, "glyphTable must start right after ASCII");
+_Static_assert(GLYPH_TABLE_LAST >= G_UP_ARROW, "GLYPH_TABLE_LAST must not come before G_UP_ARROW");
+
 unsigned int glyphToUnicode(enum displayGlyph glyph) {
     if (glyph < 128) return glyph;
 
-    switch (glyph) {
-        case G_UP_ARROW: return U_UP_ARROW;
-        case G_DOWN_ARROW: return U_DOWN_ARROW;
-        case G_POTION: return '!';
-        case G_GRASS: return '"';
-        case G_WALL: return '#';
-        case G_DEMON: return '&';
-        case G_OPEN_DOOR: return '\'';
-        case G_GOLD: return '*';
-        case G_CLOSED_DOOR: return '+';
-        case G_RUBBLE: return ',';
-        case G_KEY: return '-';
-        case G_BOG: return '~';
-        case G_CHAIN_TOP_LEFT:
-        case G_CHAIN_BOTTOM_RIGHT:
-            return '\\';
-        case G_CHAIN_TOP_RIGHT:
-        case G_CHAIN_BOTTOM_LEFT:
-            return '/';
-        case G_CHAIN_TOP:
-        case G_CHAIN_BOTTOM:
-            return '|';
-        case G_CHAIN_LEFT:
-        case G_CHAIN_RIGHT:
-            return '-';
-        case G_FOOD: return ';';
-        case G_UP_STAIRS: return '<';
-        case G_VENT: return '=';
-        case G_DOWN_STAIRS: return '>';
-        case G_PLAYER: return '@';
-        case G_BOG_MONSTER: return 'B';
-        case G_CENTAUR: return 'C';
-        case G_DRAGON: return 'D';
-        case G_FLAMEDANCER: return 'F';
-        case G_GOLEM: return 'G';
-        case G_TENTACLE_HORROR: return 'H';
-        case G_IFRIT: return 'I';
-        case G_JELLY: return 'J';
-        case G_KRAKEN: return 'K';
-        case G_LICH: return 'L';
-        case G_NAGA: return 'N';
-        case G_OGRE: return 'O';
-        case G_PHANTOM: return 'P';
-        case G_REVENANT: return 'R';
-        case G_SALAMANDER: return 'S';
-        case G_TROLL: return 'T';
-        case G_UNDERWORM: return 'U';
-        case G_VAMPIRE: return 'V';
-        case G_WRAITH: return 'W';
-        case G_ZOMBIE: return 'Z';
-        case G_ARMOR: return '[';
-        case G_STAFF: return '/';
-        case G_WEB: return ':';
-        case G_MOUND: return 'a';
-        case G_BLOAT: return 'b';
-        case G_CENTIPEDE: return 'c';
-        case G_DAR_BLADEMASTER: return 'd';
-        case G_EEL: return 'e';
-        case G_FURY: return 'f';
-        case G_GOBLIN: return 'g';
-        case G_IMP: return 'i';
-        case G_JACKAL: return 'j';
-        case G_KOBOLD: return 'k';
-        case G_MONKEY: return 'm';
-        case G_PIXIE: return 'p';
-        case G_RAT: return 'r';
-        case G_SPIDER: return 's';
-        case G_TOAD: return 't';
-        case G_BAT: return 'v';
-        case G_WISP: return 'w';
-        case G_PHOENIX: return 'P';
-        case G_ALTAR: return '|';
-        case G_LIQUID: return '~';
-        case G_FLOOR: return U_MIDDLE_DOT;
-        case G_CHASM: return U_FOUR_DOTS;
-        case G_TRAP: return U_DIAMOND;
-        case G_FIRE: return U_FLIPPED_V;
-        case G_FOLIAGE: return U_ARIES;
-        case G_AMULET: return U_ANKH;
-        case G_SCROLL: return U_MUSIC_NOTE;
-        case G_RING: return U_CIRCLE;
-        case G_WEAPON: return U_UP_ARROW;
-        case G_GEM: return U_FILLED_CIRCLE;
-        case G_TOTEM: return U_NEUTER;
-        case G_GOOD_MAGIC: return U_FILLED_CIRCLE_BARS;
-        case G_BAD_MAGIC: return U_CIRCLE_BARS;
-        case G_DOORWAY: return U_OMEGA;
-        case G_CHARM: return U_LIGHTNING_BOLT;
-        case G_WALL_TOP: return '#';
-        case G_DAR_PRIESTESS: return 'd';
-        case G_DAR_BATTLEMAGE: return 'd';
-        case G_GOBLIN_MAGIC: return 'g';
-        case G_GOBLIN_CHIEFTAN: return 'g';
-        case G_OGRE_MAGIC: return 'O';
-        case G_GUARDIAN: return U_ESZETT;
-        case G_WINGED_GUARDIAN: return U_ESZETT;
-        case G_EGG: return U_FILLED_CIRCLE;
-        case G_WARDEN: return 'Y';
-        case G_DEWAR: return '&';
-        case G_ANCIENT_SPIRIT: return 'M';
-        case G_LEVER: return '/';
-        case G_LEVER_PULLED: return '\\';
-        case G_BLOODWORT_STALK: return U_ARIES;
-        case G_FLOOR_ALT: return U_MIDDLE_DOT;
-        case G_UNICORN: return U_U_ACUTE;
-        case G_TURRET: return U_FILLED_CIRCLE;
-        case G_WAND: return '~';
-        case G_GRANITE: return '#';
-        case G_CARPET: return U_MIDDLE_DOT;
-        case G_CLOSED_IRON_DOOR: return '+';
-        case G_OPEN_IRON_DOOR: return '\'';
-        case G_TORCH: return '#';
-        case G_CRYSTAL: return '#';
-        case G_PORTCULLIS: return '#';
-        case G_BARRICADE: return '#';
-        case G_STATUE: return U_ESZETT;
-        case G_CRACKED_STATUE: return U_ESZETT;
-        case G_CLOSED_CAGE: return '#';
-        case G_OPEN_CAGE: return '|';
-        case G_PEDESTAL: return '|';
-        case G_CLOSED_COFFIN: return '-';
-        case G_OPEN_COFFIN: return '-';
-        case G_MAGIC_GLYPH: return U_FOUR_DOTS;
-        case G_BRIDGE: return '=';
-        case G_BONES: return ',';
-        case G_ELECTRIC_CRYSTAL: return U_CURRENCY;
-        case G_ASHES: return '\'';
-        case G_BEDROLL: return '=';
-        case G_BLOODWORT_POD: return '*';
-        case G_VINE: return ':';
-        case G_NET: return ':';
-        case G_LICHEN: return '"';
-        case G_PIPES: return '+';
-        case G_SAC_ALTAR: return '|';
-        case G_ORB_ALTAR: return '|';
-        case G_LEFT_TRIANGLE: return U_LEFT_TRIANGLE;
-
-        default:
-            brogueAssert(false);
-            return '?';
+    if (glyph >= G_UP_ARROW + GLYPH_TABLE_SIZE || glyphTable[glyph - G_UP_ARROW].unicode == 0) {
+        brogueAssert(false);
+        return '?';
     }
+    return glyphTable[glyph - G_UP_ARROW].unicode;
 }
 
 /*
 Tells if a glyph represents part of the environment (true) or an item or creature (false).
 */
 boolean isEnvironmentGlyph(enum displayGlyph glyph) {
-    switch (glyph) {
-        // items
-        case G_AMULET: case G_ARMOR: case G_BEDROLL: case G_CHARM:
-        case G_DEWAR: case G_EGG: case G_FOOD: case G_GEM: case G_BLOODWORT_POD:
-        case G_GOLD: case G_KEY: case G_POTION: case G_RING:
-        case G_SCROLL: case G_STAFF: case G_WAND: case G_WEAPON: case G_LEFT_TRIANGLE:
-            return false;
-
-        // creatures
-        case G_ANCIENT_SPIRIT: case G_BAT: case G_BLOAT: case G_BOG_MONSTER:
-        case G_CENTAUR: case G_CENTIPEDE: case G_DAR_BATTLEMAGE: case G_DAR_BLADEMASTER:
-        case G_DAR_PRIESTESS: case G_DEMON: case G_DRAGON: case G_EEL:
-        case G_FLAMEDANCER: case G_FURY: case G_GOBLIN: case G_GOBLIN_CHIEFTAN:
-        case G_GOBLIN_MAGIC: case G_GOLEM: case G_GUARDIAN: case G_IFRIT:
-        case G_IMP: case G_JACKAL: case G_JELLY: case G_KOBOLD:
-        case G_KRAKEN: case G_LICH: case G_MONKEY: case G_MOUND:
-        case G_NAGA: case G_OGRE: case G_OGRE_MAGIC: case G_PHANTOM:
-        case G_PHOENIX: case G_PIXIE: case G_PLAYER: case G_RAT:
-        case G_REVENANT: case G_SALAMANDER: case G_SPIDER: case G_TENTACLE_HORROR:
-        case G_TOAD: case G_TROLL: case G_UNDERWORM: case G_UNICORN:
-        case G_VAMPIRE: case G_WARDEN: case G_WINGED_GUARDIAN: case G_WISP:
-        case G_WRAITH: case G_ZOMBIE:
-            return false;
-
-        // everything else is considered part of the environment
-        default:
-            return true;
+    if (glyph < G_UP_ARROW || glyph >= G_UP_ARROW + GLYPH_TABLE_SIZE) {
+        return true;
     }
+    return glyphTable[glyph - G_UP_ARROW].environment;
 }
 
 void plotChar(enum displayGlyph inputChar,
@@ -265,57 +258,53 @@ enum graphicsModes setGraphicsMode(enum graphicsModes mode) {
     }
 }
 
-// creates an empty high scores file
+// The score table is kept in scoreBuffer for the lifetime of the process, sorted by score in
+// descending order. It is re-read only when the file is replaced behind our back
+// (its identity, modification time or size changed since we last read or wrote it).
+static boolean scoreBufferLoaded = false;
+static struct {
+    ino_t inode;
+    time_t modified;
+    off_t size;
+} scoreFileIdentity;
+
+static void saveScoreBuffer();
+
+// fills the scoreBuffer global variable with empty entries
 static void initScores() {
     short i;
-    FILE *scoresFile;
-    char highScoresFilename[BROGUE_FILENAME_MAX];
-
-    setHighScoresFilename(highScoresFilename, BROGUE_FILENAME_MAX);
 
-    scoresFile = fopen(highScoresFilename, "w");
     for (i=0; i<HIGH_SCORES_COUNT; i++) {
-        fprintf(scoresFile, "%li\t%li\t%s", (long) 0, (long) 0, "(empty entry)\n");
+        scoreBuffer[i].score = 0;
+        scoreBuffer[i].dateNumber = 0;
+        strcpy(scoreBuffer[i].description, "(empty entry)");
     }
-    fclose(scoresFile);
 }
 
-// sorts the entries of the scoreBuffer global variable by score in descending order;
-// returns the sorted line number of the most recent entry
-static short sortScoreBuffer() {
-    short i, j, highestUnsortedLine, mostRecentSortedLine = 0;
-    long highestUnsortedScore, mostRecentDate;
-    brogueScoreEntry sortedScoreBuffer[HIGH_SCORES_COUNT];
-    boolean lineSorted[HIGH_SCORES_COUNT];
+// sorts the entries of the scoreBuffer global variable by score in descending order
+// (insertion sort: the table is small and, once loaded, stays sorted)
+static void sortScoreBuffer() {
+    short i, j;
 
-    mostRecentDate = 0;
-
-    for (i=0; i<HIGH_SCORES_COUNT; i++) {
-        lineSorted[i] = false;
-    }
-
-    for (i=0; i<HIGH_SCORES_COUNT; i++) {
-        highestUnsortedLine = 0;
-        highestUnsortedScore = 0;
-        for (j=0; j<HIGH_SCORES_COUNT; j++) {
-            if (!lineSorted[j] && scoreBuffer[j].score >= highestUnsortedScore) {
-                highestUnsortedLine = j;
-                highestUnsortedScore = scoreBuffer[j].score;
-            }
+    for (i=1; i<HIGH_SCORES_COUNT; i++) {
+        brogueScoreEntry entry = scoreBuffer[i];
+        for (j=i; j>0 && scoreBuffer[j-1].score < entry.score; j--) {
+            scoreBuffer[j] = scoreBuffer[j-1];
         }
-        sortedScoreBuffer[i] = scoreBuffer[highestUnsortedLine];
-        lineSorted[highestUnsortedLine] = true;
+        scoreBuffer[j] = entry;
     }
+}
 
-    // copy the sorted list back into scoreBuffer, remember the most recent entry
-    for (i=0; i<HIGH_SCORES_COUNT; i++) {
-        scoreBuffer[i] = sortedScoreBuffer[i];
-        if (scoreBuffer[i].dateNumber > mostRecentDate) {
-            mostRecentDate = scoreBuffer[i].dateNumber;
-            mostRecentSortedLine = i;
+// returns the line number of the most recent entry of the scoreBuffer global variable
+static short mostRecentScoreLine() {
+    short i, mostRecentLine = 0;
+
+    for (i=1; i<HIGH_SCORES_COUNT; i++) {
+        if (scoreBuffer[i].dateNumber > scoreBuffer[mostRecentLine].dateNumber) {
+            mostRecentLine = i;
         }
     }
-    return mostRecentSortedLine;
+    return mostRecentLine;
 }
 
 void setHighScoresFilename(char *buffer, int bufferMaxLength) {
@@ -324,40 +313,172 @@ void setHighScoresFilename(char *buffer, int bufferMaxLength) {
     buffer[0] = toupper(buffer[0]);
 }
 
-// loads the ([V]ariantName)HighScores.txt file into the scoreBuffer global variable
+// Reads a text file line by line through a large buffer, without stdio.
+#define LINE_READER_BUFFER_SIZE 65536
+
+typedef struct lineReader {
+    int fd;
+    size_t start, end; // unread bytes are buffer[start .. end)
+    boolean eof;
+    boolean skipping;  // inside a line longer than the buffer, dropped up to its newline
+    char buffer[LINE_READER_BUFFER_SIZE];
+} lineReader;
+
+static lineReader *openLineReader(const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    lineReader *reader = malloc(sizeof(lineReader));
+    reader->fd = fd;
+    reader->start = reader->end = 0;
+    reader->eof = false;
+    reader->skipping = false;
+    return reader;
+}
+
+static void closeLineReader(lineReader *reader) {
+    close(reader->fd);
+    free(reader);
+}
+
+/// @brief Returns the next line, without its newline. The line stays valid until the next call.
+/// Lines that don't fit in the buffer are skipped.
+/// @return The line, or NULL at the end of the file
+static char *readLine(lineReader *reader) {
+    for (;;) {
+        char *line = reader->buffer + reader->start;
+        char *newline = memchr(line, '\n', reader->end - reader->start);
+        if (newline != NULL) {
+            reader->start = newline + 1 - reader->buffer;
+            if (reader->skipping) {
+                // the end of a line that didn't fit
+                reader->skipping = false;
+                continue;
+            }
+            *newline = '\0';
+            return line;
+        }
+
+        if (reader->skipping || (reader->start == 0 && reader->end == LINE_READER_BUFFER_SIZE - 1)) {
+            // a line longer than the buffer: drop it up to its newline, rather than read
+            // its tail as another line
+            reader->skipping = true;
+            reader->start = reader->end = 0;
+        } else if (reader->eof) {
+            // last line without a newline
+            if (reader->start == reader->end) {
+                return NULL;
+            }
+            reader->buffer[reader->end] = '\0';
+            reader->start = reader->end;
+            return line;
+        }
+        if (reader->eof) {
+            return NULL;
+        }
+
+        // move the partial line to the front, and read the next chunk after it
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+        ssize_t n = read(reader->fd, reader->buffer + reader->end, LINE_READER_BUFFER_SIZE - 1 - reader->end);
+        if (n <= 0) {
+            reader->eof = true;
+        } else {
+            reader->end += n;
+        }
+    }
+}
+
+/// @brief Splits the next tab-separated field off a line (destructively)
+/// @return The field; empty once the line is exhausted
+static char *nextField(char **cursor) {
+    char *field = *cursor;
+    char *tab = strchr(field, '\t');
+    if (tab != NULL) {
+        *tab = '\0';
+        *cursor = tab + 1;
+    } else {
+        *cursor = field + strlen(field);
+    }
+    return field;
+}
+
+/// @brief Parses a whole field as a decimal integer
+/// @return true if the field is a valid number
+static boolean parseInteger(const char *field, long long *value) {
+    boolean negative = (*field == '-');
+    if (negative) field++;
+    if (*field < '0' || *field > '9') {
+        return false;
+    }
+
+    unsigned long long n = 0;
+    for (; *field >= '0' && *field <= '9'; field++) {
+        n = n * 10 + (*field - '0');
+    }
+    if (*field != '\0' && *field != '\r') {
+        return false;
+    }
+    *value = (negative ? -(long long) n : (long long) n);
+    return true;
+}
+
+static void rememberScoreFile(const struct stat *statbuf) {
+    scoreFileIdentity.inode = statbuf->st_ino;
+    scoreFileIdentity.modified = statbuf->st_mtime;
+    scoreFileIdentity.size = statbuf->st_size;
+}
+
+// makes sure the scoreBuffer global variable matches the ([V]ariantName)HighScores.txt file,
+// creating the file if it doesn't exist
 // score file format is: score, tab, date in seconds, tab, description, newline.
-static short loadScoreBuffer() {
+static void loadScoreBuffer() {
     short i;
-    FILE *scoresFile;
-    time_t rawtime;
-    struct tm * timeinfo;
-
+    struct stat statbuf;
     char highScoresFilename[BROGUE_FILENAME_MAX];
     setHighScoresFilename(highScoresFilename, BROGUE_FILENAME_MAX);
 
-    scoresFile = fopen(highScoresFilename, "r");
-
-    if (scoresFile == NULL) {
+    if (stat(highScoresFilename, &statbuf)) {
+        // no file (yet, or anymore): start over with an empty table
         initScores();
-        scoresFile = fopen(highScoresFilename, "r");
+        scoreBufferLoaded = true;
+        saveScoreBuffer();
+        return;
     }
 
-    for (i=0; i<HIGH_SCORES_COUNT; i++) {
-        // load score and also the date in seconds
-        fscanf(scoresFile, "%li\t%li\t", &(scoreBuffer[i].score), &(scoreBuffer[i].dateNumber));
+    if (scoreBufferLoaded
+        && statbuf.st_ino == scoreFileIdentity.inode
+        && statbuf.st_mtime == scoreFileIdentity.modified
+        && statbuf.st_size == scoreFileIdentity.size) {
+        return; // up to date
+    }
 
-        // load description
-        fgets(scoreBuffer[i].description, COLS, scoresFile);
-        // strip the newline off the end
-        scoreBuffer[i].description[strlen(scoreBuffer[i].description) - 1] = '\0';
+    lineReader *reader = openLineReader(highScoresFilename);
 
-        // convert date to DATE_FORMAT
-        rawtime = (time_t) scoreBuffer[i].dateNumber;
-        timeinfo = localtime(&rawtime);
-        strftime(scoreBuffer[i].dateText, DCOLS, DATE_FORMAT, timeinfo);
+    for (i=0; i<HIGH_SCORES_COUNT; i++) {
+        char *line = (reader ? readLine(reader) : NULL);
+        long long score = 0, dateNumber = 0;
+
+        scoreBuffer[i].description[0] = '\0';
+        if (line != NULL) {
+            // load score and also the date in seconds
+            parseInteger(nextField(&line), &score);
+            parseInteger(nextField(&line), &dateNumber);
+
+            // load description (the rest of the line)
+            strncpy(scoreBuffer[i].description, line, COLS - 1);
+            scoreBuffer[i].description[COLS - 1] = '\0';
+        }
+        scoreBuffer[i].score = score;
+        scoreBuffer[i].dateNumber = dateNumber;
     }
-    fclose(scoresFile);
-    return sortScoreBuffer();
+    if (reader) closeLineReader(reader);
+
+    sortScoreBuffer();
+    rememberScoreFile(&statbuf);
+    scoreBufferLoaded = true;
 }
 
 void loadKeymap() {
@@ -399,23 +520,45 @@ void loadKeymap() {
 
 // saves the scoreBuffer global variable into the BrogueHighScores.txt file,
 // thus overwriting whatever is already there.
-// The numerical version of the date is what gets saved; the "mm/dd/yy" version is ignored.
+// The file is written under a temporary name then renamed over the old one, so that
+// it is never seen half-written.
 // Does NOT do any sorting.
 static void saveScoreBuffer() {
     short i;
     FILE *scoresFile;
+    struct stat statbuf;
     char highScoresFilename[BROGUE_FILENAME_MAX];
+    char temporaryFilename[BROGUE_FILENAME_MAX + 4];
 
     setHighScoresFilename(highScoresFilename, BROGUE_FILENAME_MAX);
+    snprintf(temporaryFilename, sizeof(temporaryFilename), "%s.tmp", highScoresFilename);
 
-    scoresFile = fopen(highScoresFilename, "w");
+    scoresFile = fopen(temporaryFilename, "w");
+    if (scoresFile == NULL) {
+        return;
+    }
 
     for (i=0; i<HIGH_SCORES_COUNT; i++) {
         // save the entry
         fprintf(scoresFile, "%li\t%li\t%s\n", scoreBuffer[i].score, scoreBuffer[i].dateNumber, scoreBuffer[i].description);
     }
 
+    if (fflush(scoresFile) || fsync(fileno(scoresFile))) {
+        fclose(scoresFile);
+        remove(temporaryFilename);
+        return;
+    }
     fclose(scoresFile);
+
+    if (rename(temporaryFilename, highScoresFilename)) {
+        remove(temporaryFilename);
+        return;
+    }
+
+    // our own write must not trigger a reload
+    if (!stat(highScoresFilename, &statbuf)) {
+        rememberScoreFile(&statbuf);
+    }
 }
 
 void dumpScores() {
@@ -434,256 +577,723 @@ void dumpScores() {
 short getHighScoresList(rogueHighScoresEntry returnList[HIGH_SCORES_COUNT]) {
     short i, mostRecentLineNumber;
 
-    mostRecentLineNumber = loadScoreBuffer();
+    loadScoreBuffer();
+    mostRecentLineNumber = mostRecentScoreLine();
 
     for (i=0; i<HIGH_SCORES_COUNT; i++) {
         returnList[i].score =               scoreBuffer[i].score;
-        strcpy(returnList[i].date,          scoreBuffer[i].dateText);
         strcpy(returnList[i].description,   scoreBuffer[i].description);
+
+        // convert date to DATE_FORMAT
+        time_t rawtime = (time_t) scoreBuffer[i].dateNumber;
+        strftime(returnList[i].date, sizeof(returnList[i].date), DATE_FORMAT, localtime(&rawtime));
     }
 
     return mostRecentLineNumber;
 }
 
 boolean saveHighScore(rogueHighScoresEntry theEntry) {
-    short i, lowestScoreIndex = -1;
-    long lowestScore = -1;
+    short i;
 
     loadScoreBuffer();
 
-    for (i=0; i<HIGH_SCORES_COUNT; i++) {
-        if (scoreBuffer[i].score < lowestScore || i == 0) {
-            lowestScore = scoreBuffer[i].score;
-            lowestScoreIndex = i;
-        }
-    }
-
-    if (lowestScore > theEntry.score) {
+    // the table is sorted, so the lowest score is the last one
+    if (scoreBuffer[HIGH_SCORES_COUNT - 1].score > theEntry.score) {
         return false;
     }
 
-    scoreBuffer[lowestScoreIndex].score =               theEntry.score;
-    scoreBuffer[lowestScoreIndex].dateNumber =          (long) time(NULL);
-    strcpy(scoreBuffer[lowestScoreIndex].description,   theEntry.description);
+    // insert the entry in place, dropping the lowest score
+    for (i=HIGH_SCORES_COUNT - 1; i>0 && scoreBuffer[i-1].score < theEntry.score; i--) {
+        scoreBuffer[i] = scoreBuffer[i-1];
+    }
+    scoreBuffer[i].score =               theEntry.score;
+    scoreBuffer[i].dateNumber =          (long) time(NULL);
+    strncpy(scoreBuffer[i].description,  theEntry.description, COLS - 1);
+    scoreBuffer[i].description[COLS - 1] = '\0';
 
     saveScoreBuffer();
 
     return true;
 }
 
+// Run history is an append-only binary log: a header holding aggregated stats, followed by
+// fixed-size records. Stats are updated as runs are appended, so they never require a scan.
+
+#define RUN_HISTORY_MAGIC "BRH1"
+#define RUN_RESULT_LEN 32
+#define RUN_KILLED_BY_LEN 100
+
+typedef struct runHistoryRecord {
+    uint64_t seed;          // 0 for a "reset" row
+    int64_t dateNumber;     // in seconds
+    char result[RUN_RESULT_LEN];
+    char killedBy[RUN_KILLED_BY_LEN];
+    int32_t score;
+    int32_t gold;
+    int32_t lumenstones;
+    int32_t deepestLevel;
+    int32_t turns;
+    int32_t padding;
+} runHistoryRecord;
+
+typedef struct runHistoryHeader {
+    char magic[4];
+    uint32_t recordSize;    // sizeof(runHistoryRecord), to detect layout changes
+    uint32_t recordCount;
+    uint32_t resetIndex;    // index of the first record after the most recent reset row
+    runHistoryStats allTime;
+    runHistoryStats recent; // since the most recent reset row
+} runHistoryHeader;
+
 /// @brief Sets the name of the run history file based on the variant
 /// @param buffer The filename
 /// @param bufferMaxLength The maximum filename length
-static void setRunHistoryFilename(char *buffer, int bufferMaxLength) {
-    strncpy(buffer, gameConst->variantName, bufferMaxLength);
-    strncat(buffer, "RunHistory.txt", bufferMaxLength);
+/// @param extension "txt" for the legacy text file, "bin" for the binary log
+static void setRunHistoryFilename(char *buffer, int bufferMaxLength, const char *extension) {
+    snprintf(buffer, bufferMaxLength, "%sRunHistory.%s", gameConst->variantName, extension);
     buffer[0] = toupper(buffer[0]);
 }
 
+/// @brief Adds a run to aggregated stats (same rules as the game stats screen)
+static void addRunToStats(const runHistoryRecord *run, runHistoryStats *stats) {
+    stats->games++;
+    stats->cumulativeScore += run->score;
+    stats->cumulativeGold += run->gold;
+    stats->cumulativeLevels += run->deepestLevel;
+    stats->cumulativeTurns += run->turns;
+
+    stats->highestScore = max(stats->highestScore, run->score);
+    stats->mostGold = max(stats->mostGold, run->gold);
+    stats->mostLumenstones = max(stats->mostLumenstones, run->lumenstones);
+    stats->deepestLevel = max(stats->deepestLevel, run->deepestLevel);
+
+    if (strcmp(run->result, "Escaped") == 0 || strcmp(run->result, "Mastered") == 0) {
+        if (stats->fewestTurnsWin == 0 || run->turns < stats->fewestTurnsWin) {
+            stats->fewestTurnsWin = run->turns;
+        }
+        stats->won++;
+        stats->currentWinStreak++;
+        if (strcmp(run->result, "Mastered") == 0) {
+            stats->mastered++;
+            stats->currentMasteryStreak++;
+        } else {
+            stats->escaped++;
+            stats->currentMasteryStreak = 0;
+        }
+    } else {
+        stats->currentWinStreak = 0;
+        stats->currentMasteryStreak = 0;
+    }
+    stats->longestWinStreak = max(stats->longestWinStreak, stats->currentWinStreak);
+    stats->longestMasteryStreak = max(stats->longestMasteryStreak, stats->currentMasteryStreak);
+}
+
+/// @brief Accounts for a record appended at index `header->recordCount`
+static void addRecordToHeader(runHistoryHeader *header, const runHistoryRecord *record) {
+    if (record->seed == 0) {
+        // a reset row: recent stats start over from here
+        memset(&header->recent, 0, sizeof(runHistoryStats));
+        header->resetIndex = header->recordCount + 1;
+    } else {
+        addRunToStats(record, &header->allTime);
+        addRunToStats(record, &header->recent);
+    }
+    header->recordCount++;
+}
+
+/// @brief Appends records to the open log and updates its header (records first, so that
+/// an interrupted append leaves the previous header valid)
+static void appendRunRecords(int fd, runHistoryHeader *header, const runHistoryRecord *records, uint32_t count) {
+    off_t offset = sizeof(runHistoryHeader) + (off_t) header->recordCount * sizeof(runHistoryRecord);
+    size_t size = (size_t) count * sizeof(runHistoryRecord);
+    if (pwrite(fd, records, size, offset) != (ssize_t) size) {
+        fprintf(stderr, "Error writing run history\n");
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        addRecordToHeader(header, &records[i]);
+    }
+    pwrite(fd, header, sizeof(runHistoryHeader), 0);
+}
+
+/// @brief Converts a legacy text line ("seed, date, result, killedBy, score, gold, lumenstones,
+/// depth, turns", tab separated) to a record (destroys the line)
+static boolean parseRunHistoryLine(char *line, runHistoryRecord *record) {
+    long long seed, dateNumber, numbers[5];
+
+    memset(record, 0, sizeof(runHistoryRecord));
+    if (!parseInteger(nextField(&line), &seed) || !parseInteger(nextField(&line), &dateNumber)) {
+        return false;
+    }
+    char *result = nextField(&line);
+    char *killedBy = nextField(&line);
+    for (int i = 0; i < 5; i++) {
+        if (!parseInteger(nextField(&line), &numbers[i])) {
+            return false;
+        }
+    }
+    if (*result == '\0' || *killedBy == '\0') {
+        return false;
+    }
+
+    record->seed = seed;
+    record->dateNumber = dateNumber;
+    strncpy(record->result, result, RUN_RESULT_LEN - 1);
+    strncpy(record->killedBy, killedBy, RUN_KILLED_BY_LEN - 1);
+    record->score = numbers[0];
+    record->gold = numbers[1];
+    record->lumenstones = numbers[2];
+    record->deepestLevel = numbers[3];
+    record->turns = numbers[4];
+    return true;
+}
+
+/// @brief Imports the legacy text run history, if any, into a freshly created log
+static void importLegacyRunHistory(int fd, runHistoryHeader *header) {
+    char filename[BROGUE_FILENAME_MAX];
+    setRunHistoryFilename(filename, BROGUE_FILENAME_MAX, "txt");
+
+    lineReader *reader = openLineReader(filename);
+    if (reader == NULL) {
+        return;
+    }
+
+    // parse everything first, then append it with a single write
+    uint32_t count = 0, capacity = 256, lineNumber = 0;
+    runHistoryRecord *records = malloc(capacity * sizeof(runHistoryRecord));
+    char *line;
+    while (records != NULL && (line = readLine(reader)) != NULL) {
+        lineNumber++;
+        if (count == capacity) {
+            capacity *= 2;
+            runHistoryRecord *grown = realloc(records, capacity * sizeof(runHistoryRecord));
+            if (grown == NULL) break;
+            records = grown;
+        }
+        if (parseRunHistoryLine(line, &records[count])) {
+            count++;
+        } else if (*line) {
+            fprintf(stderr, "Error parsing run history line %u\n", lineNumber);
+        }
+    }
+    closeLineReader(reader);
+
+    if (count) {
+        appendRunRecords(fd, header, records, count);
+    }
+    free(records);
+}
+
+/// @brief Writes the header of an empty log to `fd`
+/// @return `fd`, or -1 (and `fd` closed) on failure
+static int startRunHistory(int fd, runHistoryHeader *header) {
+    memset(header, 0, sizeof(runHistoryHeader));
+    memcpy(header->magic, RUN_HISTORY_MAGIC, 4);
+    header->recordSize = sizeof(runHistoryRecord);
+    if (pwrite(fd, header, sizeof(runHistoryHeader), 0) != sizeof(runHistoryHeader)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/// @brief Opens (creating it if needed) the binary run history and reads its header. The legacy
+/// text history is imported only when the log is created. A log that can't be read is renamed
+/// aside and a new one started, so its runs are never overwritten.
+/// If the header does not account for every record in the file (interrupted write), stats are rebuilt.
+/// @return The file descriptor, or -1 on failure
+static int openRunHistory(runHistoryHeader *header) {
+    char filename[BROGUE_FILENAME_MAX];
+    setRunHistoryFilename(filename, BROGUE_FILENAME_MAX, "bin");
+
+    int fd = open(filename, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat statbuf;
+    if (fstat(fd, &statbuf)) {
+        close(fd);
+        return -1;
+    }
+
+    if (statbuf.st_size == 0) {
+        // new log (or one whose creator stopped before writing its header)
+        if (startRunHistory(fd, header) < 0) {
+            return -1;
+        }
+        importLegacyRunHistory(fd, header);
+        return fd;
+    }
+
+    if (statbuf.st_size < (off_t) sizeof(runHistoryHeader)
+        || pread(fd, header, sizeof(runHistoryHeader), 0) != sizeof(runHistoryHeader)
+        || memcmp(header->magic, RUN_HISTORY_MAGIC, 4) || header->recordSize != sizeof(runHistoryRecord)) {
+
+        // unreadable log: keep it for recovery, and start over without the legacy history,
+        // which it already holds
+        char extension[32], corruptName[BROGUE_FILENAME_MAX];
+        snprintf(extension, sizeof(extension), "bin.%lld.corrupt", (long long) time(NULL));
+        setRunHistoryFilename(corruptName, BROGUE_FILENAME_MAX, extension);
+        close(fd);
+        if (rename(filename, corruptName)) {
+            fprintf(stderr, "Error moving unreadable run history aside\n");
+            return -1;
+        }
+        fprintf(stderr, "Run history was unreadable, moved it to %s\n", corruptName);
+
+        fd = open(filename, O_RDWR | O_CREAT | O_EXCL, 0644);
+        return (fd < 0) ? -1 : startRunHistory(fd, header);
+    }
+
+    uint32_t recordCount = (statbuf.st_size - sizeof(runHistoryHeader)) / sizeof(runHistoryRecord);
+    if (recordCount != header->recordCount) {
+        runHistoryRecord record;
+        header->recordCount = header->resetIndex = 0;
+        memset(&header->allTime, 0, sizeof(runHistoryStats));
+        memset(&header->recent, 0, sizeof(runHistoryStats));
+        for (uint32_t i = 0; i < recordCount; i++) {
+            off_t offset = sizeof(runHistoryHeader) + (off_t) i * sizeof(runHistoryRecord);
+            if (pread(fd, &record, sizeof(runHistoryRecord), offset) != sizeof(runHistoryRecord)) break;
+            addRecordToHeader(header, &record);
+        }
+        pwrite(fd, header, sizeof(runHistoryHeader), 0);
+    }
+    return fd;
+}
+
+static void saveRunRecord(const runHistoryRecord *record) {
+    runHistoryHeader header;
+    int fd = openRunHistory(&header);
+    if (fd < 0) {
+        fprintf(stderr, "Error opening run history\n");
+        return;
+    }
+    appendRunRecords(fd, &header, record, 1);
+    close(fd);
+}
+
 /// @brief Saves the run to the history file at the end of a game
 /// @param result The game result (Escaped, Mastered, Died, Quit)
 /// @param killedBy How the player died (monster name, etc.) 
 /// @param score The total score
 /// @param lumenstones The number of lumenstones collected
 void saveRunHistory(char *result, char *killedBy, int score, int lumenstones) {
-    FILE *runHistoryFile;
-    char runHistoryFilename[BROGUE_FILENAME_MAX];
-
-    setRunHistoryFilename(runHistoryFilename, BROGUE_FILENAME_MAX);
-    runHistoryFile = fopen(runHistoryFilename, "a"); // append. create if not found.
-
-    fprintf(runHistoryFile, "%llu\t%li\t%s\t%s\t%i\t%i\t%i\t%i\t%i\n", rogue.seed, (long) time(NULL), result, killedBy, 
-            score, (int) rogue.gold, lumenstones, (int) rogue.deepestLevel, (int) rogue.playerTurnNumber);
-    fclose(runHistoryFile);
+    runHistoryRecord record;
+    memset(&record, 0, sizeof(runHistoryRecord));
+
+    record.seed = rogue.seed;
+    record.dateNumber = time(NULL);
+    strncpy(record.result, result, RUN_RESULT_LEN - 1);
+    strncpy(record.killedBy, killedBy, RUN_KILLED_BY_LEN - 1);
+    record.score = score;
+    record.gold = rogue.gold;
+    record.lumenstones = lumenstones;
+    record.deepestLevel = rogue.deepestLevel;
+    record.turns = rogue.playerTurnNumber;
+
+    saveRunRecord(&record);
 }
 /// @brief Saves a "reset" run to the history file. This serves to reset the player's recent stats to zero.
 void saveResetRun(void) {
-    FILE *runHistoryFile;
-    char runHistoryFilename[BROGUE_FILENAME_MAX];
+    runHistoryRecord record;
+    memset(&record, 0, sizeof(runHistoryRecord));
+
+    record.dateNumber = time(NULL);
+    strcpy(record.result, "Reset");
+    strcpy(record.killedBy, "-");
+
+    saveRunRecord(&record);
+}
+
+/// @brief Reads the aggregated stats of the run history, without reading the runs themselves
+/// @param allTime Filled with the stats of every run
+/// @param recent Filled with the stats of the runs since the last reset
+/// @return true on success
+boolean getRunHistoryStats(runHistoryStats *allTime, runHistoryStats *recent) {
+    runHistoryHeader header;
+    int fd = openRunHistory(&header);
+    if (fd < 0) {
+        return false;
+    }
+    close(fd);
+
+    *allTime = header.allTime;
+    *recent = header.recent;
+    return true;
+}
+
+/// @brief Copies a record of the binary log into a run
+static void runFromRecord(rogueRun *run, const runHistoryRecord *record) {
+    memset(run, '\0', sizeof(rogueRun));
+    run->seed = record->seed;
+    run->dateNumber = record->dateNumber;
+    strncpy(run->result, record->result, sizeof(run->result) - 1);
+    strncpy(run->killedBy, record->killedBy, sizeof(run->killedBy) - 1);
+    run->score = record->score;
+    run->gold = record->gold;
+    run->lumenstones = record->lumenstones;
+    run->deepestLevel = record->deepestLevel;
+    run->turns = record->turns;
+}
+
+/// @brief Maps the records of the binary run history
+/// @param recordCount Set to the number of records
+/// @param mappedSize Set to the size to pass to munmap
+/// @return The first record, or NULL if there are none
+static const runHistoryRecord *mapRunHistory(uint32_t *recordCount, size_t *mappedSize) {
+    runHistoryHeader header;
+    int fd = openRunHistory(&header);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (header.recordCount == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    *mappedSize = sizeof(runHistoryHeader) + (size_t) header.recordCount * sizeof(runHistoryRecord);
+    void *mapped = mmap(NULL, *mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return NULL;
+    }
+    *recordCount = header.recordCount;
+    return (const runHistoryRecord *) ((const char *) mapped + sizeof(runHistoryHeader));
+}
+
+static void unmapRunHistory(const runHistoryRecord *records, size_t mappedSize) {
+    munmap((char *) records - sizeof(runHistoryHeader), mappedSize);
+}
+
+/// @brief Loads the run history into a single block: the arena header followed by every run.
+/// The runs are also linked through `nextRun`, in file order.
+/// @return The arena (release it with freeRunHistoryArena), or NULL if there are no runs
+runHistoryArena *loadRunHistoryArena(void) {
+    uint32_t recordCount;
+    size_t mappedSize;
+    const runHistoryRecord *records = mapRunHistory(&recordCount, &mappedSize);
+    if (records == NULL) {
+        return NULL;
+    }
+
+    runHistoryArena *arena = malloc(sizeof(runHistoryArena) + (size_t) recordCount * sizeof(rogueRun));
+    if (arena == NULL) {
+        unmapRunHistory(records, mappedSize);
+        return NULL;
+    }
+    arena->runs = (rogueRun *) (arena + 1);
+    arena->count = recordCount;
+
+    for (uint32_t i = 0; i < recordCount; i++) {
+        runFromRecord(&arena->runs[i], &records[i]);
+        arena->runs[i].nextRun = (i + 1 < recordCount ? &arena->runs[i + 1] : NULL);
+    }
+    unmapRunHistory(records, mappedSize);
+
+    return arena;
+}
 
-    setRunHistoryFilename(runHistoryFilename, BROGUE_FILENAME_MAX);
-    runHistoryFile = fopen(runHistoryFilename, "a"); // append. create if not found.
+void freeRunHistoryArena(runHistoryArena *arena) {
+    free(arena);
+}
 
-    fprintf(runHistoryFile, "%i\t%li\t%s\t%s\t%i\t%i\t%i\t%i\t%i\n", 0, (long) time(NULL), "Reset", "-", 0, 0, 0, 0, 0);
-    fclose(runHistoryFile);
+/// @brief Iterates over the runs of an arena:
+/// `runHistoryIterator it = {arena}; while ((run = nextRunInHistory(&it))) ...`
+/// @return The next run, or NULL at the end
+const rogueRun *nextRunInHistory(runHistoryIterator *iterator) {
+    if (iterator->arena == NULL || iterator->index >= iterator->arena->count) {
+        return NULL;
+    }
+    return &iterator->arena->runs[iterator->index++];
 }
 
 /// @brief Loads the run history file
-/// @return Linked list of runs
+/// @return Linked list of runs, or NULL if there are none. The runs are the contiguous array of
+/// an arena, so release the list with freeRunHistory rather than node by node.
 rogueRun* loadRunHistory(void) {
-    FILE *runHistoryFile;
-    char runHistoryFilename[BROGUE_FILENAME_MAX];
-
-    setRunHistoryFilename(runHistoryFilename, BROGUE_FILENAME_MAX);
-    runHistoryFile = fopen(runHistoryFilename, "r"); // read
+    runHistoryArena *arena = loadRunHistoryArena();
+    return arena ? arena->runs : NULL;
+}
 
-    if (runHistoryFile == NULL) {
-        runHistoryFile = fopen(runHistoryFilename, "w"); // create if not found
-        fclose(runHistoryFile);
-        runHistoryFile = fopen(runHistoryFilename, "r");
+/// @brief Releases a list returned by loadRunHistory
+void freeRunHistory(rogueRun *runHistory) {
+    if (runHistory) {
+        freeRunHistoryArena((runHistoryArena *) runHistory - 1);
     }
+}
 
     rogueRun *runHistory = NULL;
     rogueRun *current = NULL;
-    char line[1024]; // maximum line length
-    while (fgets(line, sizeof(line), runHistoryFile) != NULL) {
+    for (uint32_t i = 0; i < recordCount; i++) {
         rogueRun *run = (rogueRun *)malloc(sizeof(rogueRun));
-        memset(run, '\0', sizeof(rogueRun));
+        runFromRecord(run, &records[i]);
         run->nextRun = NULL;
 
-        int vals = sscanf(line, "%llu\t%li\t%s\t%[^\t]\t%i\t%i\t%i\t%i\t%i\n", &run->seed, &run->dateNumber,
-                   run->result, run->killedBy, &run->score, &run->gold, &run->lumenstones,
-                   &run->deepestLevel, &run->turns);
-
-        if ( vals == 9) {
-            if (runHistory == NULL) {
-                runHistory = run;
-                current = run;
-            } else {
-                current->nextRun = run;
-                current = run;
-            }
+        if (runHistory == NULL) {
+            runHistory = run;
+            current = run;
         } else {
-            fprintf(stderr, "Error parsing line: %s\n", line);
-            free(run);
+            current->nextRun = run;
+            current = run;
         }
     }
-    fclose(runHistoryFile);
+    unmapRunHistory(records, mappedSize);
 
     return runHistory;
 }
 
 // start of file listing
 
-struct filelist {
-    fileEntry *files;
+// The save folder is indexed once and the index is kept in memory and on disk. It is
+// trusted as long as the folder's modification time (which changes whenever a file is
+// added, removed or renamed in it) is the one recorded after the last scan, that
+// scan started in a later second (otherwise a change could hide in the same second),
+// and every indexed file still has the modification time and size it was indexed with
+// (a file rewritten in place leaves the folder alone).
+// Only saved games and recordings are indexed, newest first.
+
+#define FILE_INDEX_FILENAME ".brogue_file_index"
+#define FILE_INDEX_MAGIC "BFI2"
+
+static const char *indexedSuffixes[] = {".broguesave", ".broguerec", NULL};
+
+typedef struct fileIndexHeader {
+    char magic[4];
+    int32_t count;
+    int64_t directoryModified; // folder modification time after the index was written
+    int64_t scanned;           // time at which the scan started
+    int32_t namesLength;
+    int32_t padding;
+} fileIndexHeader;
+
+typedef struct fileIndexEntry {
+    int64_t modified;
+    int64_t size;
+    int32_t nameOffset;
+    int32_t padding;
+} fileIndexEntry;
+
+static struct {
+    boolean loaded;
+    fileIndexHeader header;
+    fileIndexEntry *entries;
+    fileEntry *files; // paths point into `names`
     char *names;
+} fileIndex;
 
-    int nfiles, maxfiles;
-    int nextname, maxname;
-};
-
-static struct filelist *newFilelist() {
-    struct filelist *list = malloc(sizeof(*list));
-
-    list->nfiles = 0;
-    list->nextname = 0;
-    list->maxfiles = 64;
-    list->maxname = list->maxfiles * 64;
+static boolean hasIndexedSuffix(const char *name) {
+    size_t length = strlen(name);
+    for (int i = 0; indexedSuffixes[i]; i++) {
+        size_t suffixLength = strlen(indexedSuffixes[i]);
+        if (length > suffixLength && strcmp(name + length - suffixLength, indexedSuffixes[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
 
-    list->files = malloc(sizeof(fileEntry) * list->maxfiles);
-    list->names = malloc(list->maxname);
+static int compareIndexEntries(const void *a, const void *b) {
+    int64_t dateA = ((const fileIndexEntry *) a)->modified;
+    int64_t dateB = ((const fileIndexEntry *) b)->modified;
+    return (dateA < dateB) - (dateA > dateB); // newest first
+}
 
-    return list;
+static void clearFileIndex() {
+    free(fileIndex.entries);
+    free(fileIndex.files);
+    free(fileIndex.names);
+    memset(&fileIndex, 0, sizeof(fileIndex));
 }
 
-static fileEntry *addfile(struct filelist *list, const char *name) {
-    int len = strlen(name);
-    if (len + list->nextname >= list->maxname) {
-        int newmax = (list->maxname + len) * 2;
-        char *newnames = realloc(list->names, newmax);
-        if (newnames != NULL) {
-            list->names = newnames;
-            list->maxname = newmax;
-        } else {
-            // fail silently
-            return NULL;
-        }
+// converts the dates once, so that listing the files does not need to
+static boolean buildFileEntries() {
+    int count = fileIndex.header.count;
+    fileIndex.files = malloc(max(1, count) * sizeof(fileEntry));
+    if (fileIndex.files == NULL) {
+        return false;
     }
-
-    if (list->nfiles >= list->maxfiles) {
-        int newmax = list->maxfiles * 2;
-        fileEntry *newfiles = realloc(list->files, sizeof(fileEntry) * newmax);
-        if (newfiles != NULL) {
-            list->files = newfiles;
-            list->maxfiles = newmax;
+    for (int i = 0; i < count; i++) {
+        time_t modified = (time_t) fileIndex.entries[i].modified;
+        struct tm *date = localtime(&modified);
+        fileIndex.files[i].path = fileIndex.names + fileIndex.entries[i].nameOffset;
+        if (date) {
+            fileIndex.files[i].date = *date;
         } else {
-            // fail silently
-            return NULL;
+            memset(&fileIndex.files[i].date, 0, sizeof(struct tm));
         }
     }
+    fileIndex.loaded = true;
+    return true;
+}
 
-    // add the new file and copy the name into the buffer
-    list->files[list->nfiles].path = ((char *) NULL) + list->nextname; // don't look at them until they are transferred out
-    list->files[list->nfiles].date = (struct tm) {0}; // associate a dummy date (1899-12-31) to avoid random data, it will be correctly populated when using listFiles()
+static boolean loadFileIndex() {
+    clearFileIndex();
 
-    strncpy(list->names + list->nextname, name, len + 1);
+    int fd = open(FILE_INDEX_FILENAME, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
 
-    list->nextname += len + 1;
-    list->nfiles += 1;
+    fileIndexHeader header;
+    boolean ok = (read(fd, &header, sizeof(header)) == sizeof(header)
+                  && memcmp(header.magic, FILE_INDEX_MAGIC, 4) == 0
+                  && header.count >= 0 && header.namesLength >= 0);
+    if (ok) {
+        size_t entriesSize = (size_t) header.count * sizeof(fileIndexEntry);
+        fileIndex.entries = malloc(max(1, entriesSize));
+        fileIndex.names = malloc(max(1, header.namesLength));
+        ok = (fileIndex.entries && fileIndex.names
+              && read(fd, fileIndex.entries, entriesSize) == (ssize_t) entriesSize
+              && read(fd, fileIndex.names, header.namesLength) == header.namesLength);
+        for (int i = 0; ok && i < header.count; i++) {
+            ok = (fileIndex.entries[i].nameOffset >= 0 && fileIndex.entries[i].nameOffset < header.namesLength);
+        }
+        ok = ok && (header.namesLength == 0 || fileIndex.names[header.namesLength - 1] == '\0');
+    }
+    close(fd);
 
-    return list->files + (list->nfiles - 1);
+    if (ok) {
+        fileIndex.header = header;
+        ok = buildFileEntries();
+    }
+    if (!ok) {
+        clearFileIndex();
+    }
+    return ok;
 }
 
-static void freeFilelist(struct filelist *list) {
-    //if (list->names != NULL) free(list->names);
-    //if (list->files != NULL) free(list->files);
-    free(list);
+// writes the index in place (rewriting an existing file does not touch the folder's
+// modification time), then records the folder's modification time in it
+static void saveFileIndex() {
+    int fd = open(FILE_INDEX_FILENAME, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat statbuf;
+    size_t entriesSize = (size_t) fileIndex.header.count * sizeof(fileIndexEntry);
+    size_t totalSize = sizeof(fileIndexHeader) + entriesSize + fileIndex.header.namesLength;
+    boolean ok = (pwrite(fd, fileIndex.entries, entriesSize, sizeof(fileIndexHeader)) == (ssize_t) entriesSize
+                  && pwrite(fd, fileIndex.names, fileIndex.header.namesLength, sizeof(fileIndexHeader) + entriesSize)
+                     == fileIndex.header.namesLength
+                  && ftruncate(fd, totalSize) == 0
+                  && stat("./", &statbuf) == 0);
+    if (ok) {
+        fileIndex.header.directoryModified = statbuf.st_mtime;
+        ok = (pwrite(fd, &fileIndex.header, sizeof(fileIndexHeader), 0) == sizeof(fileIndexHeader));
+    }
+    if (!ok) {
+        ftruncate(fd, 0); // never leave a half-written index behind
+    }
+    close(fd);
 }
 
-static fileEntry *commitFilelist(struct filelist *list, char **namebuffer) {
-    int i;
-    /*fileEntry *files = malloc(list->nfiles * sizeof(fileEntry) + list->nextname); // enough space for all the names and all the files
+static boolean scanDirectory() {
+    clearFileIndex();
 
-    if (files != NULL) {
-        char *names = (char *) (files + list->nfiles);
+    DIR *dp = opendir("./");
+    if (dp == NULL) {
+        return false;
+    }
 
-        for (i=0; i < list->nfiles; i++) {
-            files[i] = list->files[i];
-            files[i].path = names + (files[i].path - (char *) NULL);
+    int capacity = 64, namesCapacity = 64 * 64;
+    memcpy(fileIndex.header.magic, FILE_INDEX_MAGIC, 4);
+    fileIndex.header.scanned = time(NULL);
+    fileIndex.entries = malloc(capacity * sizeof(fileIndexEntry));
+    fileIndex.names = malloc(namesCapacity);
+
+    struct dirent *ep;
+    struct stat statbuf;
+    while (fileIndex.entries && fileIndex.names && (ep = readdir(dp))) {
+        // get statistics about the file (0 on success)
+        if (!hasIndexedSuffix(ep->d_name) || stat(ep->d_name, &statbuf)) {
+            continue;
         }
 
-        memcpy(names, list->names, list->nextname);
+        int length = strlen(ep->d_name) + 1;
+        if (fileIndex.header.count == capacity) {
+            capacity *= 2;
+            fileIndexEntry *entries = realloc(fileIndex.entries, capacity * sizeof(fileIndexEntry));
+            if (entries == NULL) break; // fail silently
+            fileIndex.entries = entries;
+        }
+        if (fileIndex.header.namesLength + length > namesCapacity) {
+            namesCapacity = (namesCapacity + length) * 2;
+            char *names = realloc(fileIndex.names, namesCapacity);
+            if (names == NULL) break; // fail silently
+            fileIndex.names = names;
+        }
+
+        fileIndexEntry *entry = &fileIndex.entries[fileIndex.header.count++];
+        entry->modified = statbuf.st_mtime;
+        entry->size = statbuf.st_size;
+        entry->nameOffset = fileIndex.header.namesLength;
+        entry->padding = 0;
+        memcpy(fileIndex.names + fileIndex.header.namesLength, ep->d_name, length);
+        fileIndex.header.namesLength += length;
     }
-    */
-    for (i=0; i < list->nfiles; i++) {
-        list->files[i].path = list->names + (list->files[i].path - (char *) NULL);
+    closedir(dp);
+
+    if (!fileIndex.entries || !fileIndex.names) {
+        clearFileIndex();
+        return false;
     }
-    *namebuffer = list->names;
 
-    return list->files;
+    qsort(fileIndex.entries, fileIndex.header.count, sizeof(fileIndexEntry), compareIndexEntries);
+    saveFileIndex();
+    return buildFileEntries();
 }
 
-fileEntry *listFiles(short *fileCount, char **namebuffer) {
-    struct filelist *list = newFilelist();
-
-    // windows: FindFirstFile/FindNextFile
-    DIR *dp= opendir ("./");
-
-    if (dp != NULL) {
-        struct dirent *ep;
-        struct stat statbuf;
-        struct tm *timeinfo;
-
-        while ((ep = readdir(dp))) {
-            // get statistics about the file (0 on success)
-            if (!stat(ep->d_name, &statbuf)) {
-                fileEntry *file = addfile(list, ep->d_name);
-                if (file != NULL) {
-                    // add the modification date to the file entry
-                    timeinfo = localtime(&statbuf.st_mtime);
-                    file->date = *timeinfo;
-                }
-            }
+static boolean indexedFilesUnchanged() {
+    struct stat statbuf;
+    for (int i = 0; i < fileIndex.header.count; i++) {
+        const fileIndexEntry *entry = &fileIndex.entries[i];
+        if (stat(fileIndex.names + entry->nameOffset, &statbuf)
+            || statbuf.st_mtime != entry->modified || statbuf.st_size != entry->size) {
+            return false;
         }
-
-        closedir (dp);
     }
-    else {
-        *fileCount = 0;
+    return true;
+}
+
+fileEntry *listFiles(short *fileCount, char **namebuffer) {
+    struct stat statbuf;
+
+    *fileCount = 0;
+    if (stat("./", &statbuf)) {
         return NULL;
     }
 
-    fileEntry *files = commitFilelist(list, namebuffer);
-
-    if (files != NULL) {
-        *fileCount = (short) list->nfiles;
-    } else {
-        *fileCount = 0;
+    if (!fileIndex.loaded) {
+        loadFileIndex();
+    }
+    if (!fileIndex.loaded
+        || fileIndex.header.directoryModified != statbuf.st_mtime
+        || fileIndex.header.directoryModified >= fileIndex.header.scanned
+        || !indexedFilesUnchanged()) {
+        if (!scanDirectory()) {
+            return NULL;
+        }
     }
 
-    freeFilelist(list);
+    // hand out a copy: the caller frees both the files and the names
+    int count = fileIndex.header.count;
+    fileEntry *files = malloc(max(1, count) * sizeof(fileEntry));
+    char *names = malloc(max(1, fileIndex.header.namesLength));
+    if (files == NULL || names == NULL) {
+        free(files);
+        free(names);
+        return NULL;
+    }
+    memcpy(names, fileIndex.names, fileIndex.header.namesLength);
+    for (int i = 0; i < count; i++) {
+        files[i].path = names + fileIndex.entries[i].nameOffset;
+        files[i].date = fileIndex.files[i].date;
+    }
 
+    *fileCount = (short) count;
+    *namebuffer = names;
     return files;
 }
 
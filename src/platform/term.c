@@ -1,10 +1,14 @@
 #include <ncurses.h>
 #include "term.h"
 #include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "Rogue.h"
 #include <ctype.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
 
 
 // As a rule, everything in term.c is the result of gradual evolutionary
@@ -22,6 +26,7 @@ static struct { int curses, color; } videomode = { 0, 0 };
 static struct { int width, height; } minsize = { 80, 24 };
 
 static void init_coersion();
+static void report_output_stats();
 
 
 // 256 color mode stuff
@@ -31,14 +36,26 @@ typedef struct {
     int r, g, b, idx;
 } intcolor;
 
+// ncurses color pairs 16..255, allocated on demand and kept across refreshes
+#define PRS_FIRST 16
+#define PRS_COUNT 256
+#define PRS_TABLE_SIZE 512 // must be a power of two, and comfortably larger than PRS_COUNT
+
 struct {
     intcolor fore, back;
-    int count, next;
-} prs[256];
+    int refs;               // number of screen cells currently drawn with this pair
+    unsigned long lastUsed; // frame in which the pair was last looked up, for LRU eviction
+} prs[PRS_COUNT];
+
+// open-addressing (linear probing) index from (fore.idx, back.idx) to a pair in `prs`, 0 if empty
+static short prs_table[PRS_TABLE_SIZE];
+static int prs_next;            // next pair that has never been allocated
+static unsigned long prs_frame; // incremented on every 256-color refresh
 
 
 typedef struct {
     int ch, pair, shuffle;
+    int drawn, drawnCh; // 256 color mode: pair and character currently on screen (pair 0 if none)
     intcolor fore, back;
 } pairmode_cell;
 
@@ -179,6 +196,7 @@ static void term_end() {
     clear();
     refresh();
     endwin();
+    report_output_stats();
 }
 
 typedef struct CIE {
@@ -220,6 +238,23 @@ CIE ciePalette[16];
 Lab labPalette[16];
 CIE adamsPalette[16];
 
+// 16 color mode: memo of best() results, keyed by the (fg, bg) pair quantized to 8 bits per channel.
+// Brogue only uses a handful of distinct colors on any given frame, so most cells are hits.
+#define COLORING_CACHE_SIZE 4096 // must be a power of two
+#define COLORING_CACHE_PROBES 4
+#define COLORING_KEY_VALID ((uint64_t) 1 << 63)
+
+typedef struct {
+    uint64_t key; // quantized fg and bg, or 0 when the slot is empty
+    int coloring;
+} coloring_cache_entry;
+
+static coloring_cache_entry coloring_cache[COLORING_CACHE_SIZE];
+
+static struct {
+    unsigned long hits, misses;
+} coloring_cache_stats;
+
 static CIE white;
 
 static CIE toCIE(fcolor c) {
@@ -297,6 +332,9 @@ static void init_coersion() {
         initialize_prs();
     }
 
+    // the palette may have changed, so forget what we matched against it
+    memset(coloring_cache, 0, sizeof(coloring_cache));
+
     cell_buffer = 0;
 }
 
@@ -360,17 +398,73 @@ static int best (fcolor *fg, fcolor *bg) {
     }
 }
 
+static uint64_t quantize_channel(float c) {
+    return c <= 0 ? 0 : c >= 1 ? 255 : (uint64_t) (c * 255 + 0.5);
+}
 
+static int best_cached(fcolor *fg, fcolor *bg) {
+    uint64_t key = COLORING_KEY_VALID
+        | quantize_channel(fg->r) << 40 | quantize_channel(fg->g) << 32 | quantize_channel(fg->b) << 24
+        | quantize_channel(bg->r) << 16 | quantize_channel(bg->g) << 8 | quantize_channel(bg->b);
+
+    // fibonacci hashing, then a short linear probe
+    unsigned home = (unsigned) ((key * 0x9E3779B97F4A7C15ull) >> 52) & (COLORING_CACHE_SIZE - 1);
+    unsigned slot = home;
+    int i;
+    for (i = 0; i < COLORING_CACHE_PROBES; i++) {
+        coloring_cache_entry *e = &coloring_cache[(home + i) & (COLORING_CACHE_SIZE - 1)];
+        if (e->key == key) {
+            coloring_cache_stats.hits++;
+            return e->coloring;
+        }
+        if (e->key == 0) {
+            slot = (home + i) & (COLORING_CACHE_SIZE - 1);
+            break;
+        }
+    }
+
+    // not found: compute it, and take the first empty slot (or evict the home slot)
+    coloring_cache_stats.misses++;
+    int coloring = best(fg, bg);
+    coloring_cache[slot].key = key;
+    coloring_cache[slot].coloring = coloring;
+    return coloring;
+}
 
 
 static void initialize_prs() {
-    int i;
-    for (i = 16; i < 255; i++) {
-        prs[i].next = i + 1;
+    memset(prs, 0, sizeof(prs));
+    memset(prs_table, 0, sizeof(prs_table));
+    prs_next = PRS_FIRST;
+    prs_frame = 0;
+}
+
+static unsigned prs_slot(int fg_idx, int bg_idx) {
+    return ((unsigned) (fg_idx * 256 + bg_idx) * 2654435761u >> 16) & (PRS_TABLE_SIZE - 1);
+}
+
+static void prs_table_insert(int pair) {
+    unsigned slot = prs_slot(prs[pair].fore.idx, prs[pair].back.idx);
+    while (prs_table[slot]) slot = (slot + 1) & (PRS_TABLE_SIZE - 1);
+    prs_table[slot] = pair;
+}
+
+static void prs_table_remove(int pair) {
+    unsigned slot = prs_slot(prs[pair].fore.idx, prs[pair].back.idx);
+    while (prs_table[slot] != pair) slot = (slot + 1) & (PRS_TABLE_SIZE - 1);
+    prs_table[slot] = 0;
+
+    // backward-shift the rest of the cluster so that lookups never stop early
+    unsigned hole = slot;
+    for (slot = (slot + 1) & (PRS_TABLE_SIZE - 1); prs_table[slot]; slot = (slot + 1) & (PRS_TABLE_SIZE - 1)) {
+        int moved = prs_table[slot];
+        unsigned home = prs_slot(prs[moved].fore.idx, prs[moved].back.idx);
+        if (((slot - home) & (PRS_TABLE_SIZE - 1)) >= ((slot - hole) & (PRS_TABLE_SIZE - 1))) {
+            prs_table[hole] = moved;
+            prs_table[slot] = 0;
+            hole = slot;
+        }
     }
-    prs[0].next = 16;
-    prs[1].next = 0;
-    prs[255].next = 0;
 }
 
 static void coerce_colorcube (fcolor *f, intcolor *c) {
@@ -407,54 +501,56 @@ static int intcolor_distance (intcolor *a, intcolor *b) {
 }
 
 static int coerce_prs (intcolor *fg, intcolor *bg) {
-    // search for an exact match in the list
+    // search for an exact match in the table
     int pair;
-    pair = prs[1].next;
-    while (pair) {
+    unsigned slot = prs_slot(fg->idx, bg->idx);
+    while ((pair = prs_table[slot])) {
         if (prs[pair].fore.idx == fg->idx && prs[pair].back.idx == bg->idx) {
             // perfect.
-            prs[pair].count++;
+            prs[pair].lastUsed = prs_frame;
             return pair;
         }
-        pair = prs[pair].next;
+        slot = (slot + 1) & (PRS_TABLE_SIZE - 1);
     }
 
-    // no exact match? try to insert it as a new one
-    pair = prs[0].next;
-    if (pair) {
-        // there's room!
-
-        // remove
-        prs[0].next = prs[pair].next;
-
-        // insert at the front
-        prs[pair].next = prs[1].next;
-        prs[1].next = pair;
+    // no exact match? take a pair that was never used, or else evict the least recently
+    // used pair that is no longer on screen (redefining a visible pair would recolor it)
+    pair = 0;
+    if (prs_next < PRS_COUNT) {
+        pair = prs_next++;
+    } else {
+        int i;
+        for (i = PRS_FIRST; i < PRS_COUNT; i++) {
+            if (!prs[i].refs && (!pair || prs[i].lastUsed < prs[pair].lastUsed)) pair = i;
+        }
+        if (pair) prs_table_remove(pair);
+    }
 
+    if (pair) {
         // initialize it
         prs[pair].fore = *fg;
         prs[pair].back = *bg;
-        prs[pair].count = 1;
+        prs[pair].refs = 0;
+        prs[pair].lastUsed = prs_frame;
+        prs_table_insert(pair);
 
         init_pair(pair, fg->idx, bg->idx);
 
         return pair;
     }
 
-    // search for an approximate match in the list
-    int bestpair = 0, bestscore = 2 * 3 * 6 * 6; // naive distance metric for now
-    pair = prs[1].next;
-    while (pair) {
+    // every pair is on screen: settle for an approximate match
+    int bestpair = PRS_FIRST, bestscore = 2 * 3 * 6 * 6; // naive distance metric for now
+    for (pair = PRS_FIRST; pair < PRS_COUNT; pair++) {
         int delta = intcolor_distance(&prs[pair].fore, fg) + intcolor_distance(&prs[pair].back, bg);
         if (delta < bestscore) {
             bestscore = delta;
             bestpair = pair;
             if (delta == 1) break; // as good as it gets without being exact!
         }
-        pair = prs[pair].next;
     }
 
-    prs[bestpair].count++;
+    prs[bestpair].lastUsed = prs_frame;
     return bestpair;
 }
 
@@ -510,42 +606,166 @@ static void buffer_plot(int ch, int x, int y, fcolor *fg, fcolor *bg) {
     cell_buffer[cell].back = cube_bg;
 }
 
+static int fullRefresh = 1; // screen needs a full refresh
+
 static void buffer_render_256() {
-    // build a new palette
-    initialize_prs();
+    char run[COLS + 1]; // characters of consecutive changed cells sharing one pair
+    int runX = 0, runLength = 0, runPair = 0;
+    int x, y;
 
-    int length = minsize.width * minsize.height;
-    int i, idx, x, y;
+    prs_frame++;
 
-    for (i = 0; i < length; i++) {
-        cell_buffer[i].shuffle = i;
-    }
-    for (i = length - 1; i >= 0; i--) {
-        // int roll = i == 0 ? 0 : rand() % i;
-        // idx = cell_buffer[roll].shuffle;
+    // only the cells plotted since the last refresh (`pair` set to -1) need a pair, and only those
+    // whose character or pair actually changed need a redraw; the others are still on screen,
+    // and keep their pair alive through its reference count
+    for (y = 0; y < minsize.height; y++) {
+        for (x = 0; x <= minsize.width; x++) {
+            pairmode_cell *c = (x < minsize.width ? &cell_buffer[x + y * minsize.width] : NULL);
+            boolean redraw = false;
+
+            if (c && c->pair == -1) {
+                c->pair = coerce_prs(&c->fore, &c->back);
+                if (c->drawn) prs[c->drawn].refs--;
+                prs[c->pair].refs++;
+                redraw = (c->pair != c->drawn || c->ch != c->drawnCh);
+                c->drawn = c->pair;
+                c->drawnCh = c->ch;
+            } else if (c && fullRefresh && c->drawn) {
+                redraw = true;
+            }
 
-        // cell_buffer[roll].shuffle = cell_buffer[i].shuffle;
+            // not plain ASCII: addnstr would decode it as part of a multibyte string
+            boolean ascii = redraw && c->ch >= 0 && c->ch <= 0x7f;
 
-        idx = i;
+            // end the current run at the end of the line, on a gap, on a pair change, before a
+            // character drawn on its own, or when it's full
+            if (runLength && (!ascii || c->pair != runPair || runLength == (int) sizeof(run) - 1)) {
+                color_set(runPair, NULL);
+                mvaddnstr(y, runX, run, runLength);
+                runLength = 0;
+            }
+            if (!redraw) continue;
 
-        int pair = coerce_prs(&cell_buffer[idx].fore, &cell_buffer[idx].back);
-        cell_buffer[idx].pair = pair;
-    }
+            if (!ascii) {
+                color_set(c->pair, NULL);
+                mvaddch(y, x, c->ch);
+                continue;
+            }
 
-    // render it all!
-    i = 0;
-    for (y = 0; y < minsize.height; y++) {
-        move(y, 0);
-        for (x = 0; x < minsize.width; x++) {
-            color_set(cell_buffer[i].pair, NULL);
-            addch(cell_buffer[i].ch);
-            i++;
+            if (!runLength) {
+                runX = x;
+                runPair = c->pair;
+            }
+            run[runLength++] = c->ch;
         }
     }
     refresh();
+    fullRefresh = 0;
 }
 
-static int fullRefresh = 1; // screen needs a full refresh
+// truecolor mode: escape sequences for a whole frame are built in `escbuf` and sent with a single write()
+static struct {
+    char *data;
+    size_t length, capacity;
+} escbuf;
+
+static struct {
+    unsigned long lastFrameBytes; // bytes written by the most recent refresh
+    unsigned long long totalBytes;
+    unsigned long frames;
+} term_output_stats;
+
+// with BROGUE_TERM_STATS set, print how much went to the terminal once it's back to normal,
+// to judge what a frame costs over a slow link, and how well 16 color mode's coloring cache did
+static void report_output_stats() {
+    if (!getenv("BROGUE_TERM_STATS")) return;
+    if (term_output_stats.frames) {
+        fprintf(stderr, "Terminal output: %lu frames, %llu bytes, %llu bytes per frame, %lu in the last\n",
+            term_output_stats.frames, term_output_stats.totalBytes,
+            term_output_stats.totalBytes / term_output_stats.frames, term_output_stats.lastFrameBytes);
+    }
+    if (coloring_cache_stats.hits + coloring_cache_stats.misses) {
+        fprintf(stderr, "Coloring cache: %lu hits, %lu misses\n",
+            coloring_cache_stats.hits, coloring_cache_stats.misses);
+    }
+}
+
+static void escbuf_reserve(size_t extra) {
+    if (escbuf.length + extra <= escbuf.capacity) return;
+    size_t capacity = escbuf.capacity ? escbuf.capacity : 4096;
+    while (capacity < escbuf.length + extra) capacity *= 2;
+    char *data = realloc(escbuf.data, capacity);
+    if (data == NULL) {
+        fprintf(stderr, "Out of memory for terminal output\n");
+        exit(EXIT_STATUS_FAILURE_PLATFORM_ERROR);
+    }
+    escbuf.data = data;
+    escbuf.capacity = capacity;
+}
+
+// callers reserve space first; no single sequence below is longer than 24 bytes
+#define ESCBUF_MAX_SEQUENCE 24
+
+static void escbuf_char(char c) {
+    escbuf.data[escbuf.length++] = c;
+}
+
+static void escbuf_int(unsigned n) {
+    char digits[10];
+    int count = 0;
+    do {
+        digits[count++] = '0' + n % 10;
+        n /= 10;
+    } while (n);
+    while (count) escbuf.data[escbuf.length++] = digits[--count];
+}
+
+static void escbuf_rgb(int selector, intcolor *c) {
+    // ESC [ 38;2;r;g;b m (foreground) or ESC [ 48;2;r;g;b m (background)
+    escbuf_char('\033'); escbuf_char('[');
+    escbuf_int(selector); escbuf_char(';'); escbuf_char('2'); escbuf_char(';');
+    escbuf_int(c->r); escbuf_char(';');
+    escbuf_int(c->g); escbuf_char(';');
+    escbuf_int(c->b); escbuf_char('m');
+}
+
+static void escbuf_move(int fromX, int fromY, int x, int y) {
+    escbuf_char('\033'); escbuf_char('[');
+    if (fromY == y && x > fromX && x - fromX < 10) {
+        // skipping a few cells on the same line: cursor forward is shorter than an absolute move
+        if (x - fromX > 1) escbuf_int(x - fromX);
+        escbuf_char('C');
+    } else {
+        escbuf_int(y + 1); escbuf_char(';');
+        escbuf_int(x + 1); escbuf_char('f');
+    }
+}
+
+static void escbuf_flush() {
+    fflush(stdout); // anything printf'ed before (e.g. the title) must come first
+
+    // a frame cut short leaves the screen wrong until the next full redraw, so retry on
+    // interruptions, and wait out a non-blocking terminal that is full
+    size_t sent = 0;
+    while (sent < escbuf.length) {
+        ssize_t n = write(STDOUT_FILENO, escbuf.data + sent, escbuf.length - sent);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd out = {.fd = STDOUT_FILENO, .events = POLLOUT};
+            if (poll(&out, 1, -1) < 0 && errno != EINTR) break;
+        } else {
+            break;
+        }
+    }
+
+    term_output_stats.lastFrameBytes = sent;
+    term_output_stats.totalBytes += sent;
+    term_output_stats.frames++;
+    escbuf.length = 0;
+}
 
 static void buffer_render_24bit() {
     int cx, cy;      // cursor coordinates
@@ -553,6 +773,8 @@ static void buffer_render_24bit() {
 
     cx = cy = fg.r = fg.g = fg.b = bg.r = bg.g = bg.b = -1;
 
+    escbuf.length = 0;
+
     for (int y = 0; y < minsize.height; y++) {
         for (int x = 0; x < minsize.width; x++) {
             pairmode_cell *c = &cell_buffer[x + y * minsize.width];
@@ -561,31 +783,33 @@ static void buffer_render_24bit() {
             if (!c->pair && !fullRefresh) continue;
             c->pair = 0;
 
+            escbuf_reserve(3 * ESCBUF_MAX_SEQUENCE + 1);
+
             // change background color
             if (c->back.r != bg.r || c->back.g != bg.g || c->back.b != bg.b) {
                 bg = c->back;
-                printf("\033[48;2;%d;%d;%dm", bg.r, bg.g, bg.b);
+                escbuf_rgb(48, &bg);
             }
 
             // change foreground color (doesn't matter for whitespace)
             if (c->ch != ' ' && (fg.r != c->fore.r || fg.g != c->fore.g || fg.b != c->fore.b)) {
                 fg = c->fore;
-                printf("\033[38;2;%d;%d;%dm", fg.r, fg.g, fg.b);
+                escbuf_rgb(38, &fg);
             }
 
             // move cursor if necessary
             if (cx != x || cy != y) {
+                escbuf_move(cx, cy, x, y);
                 cx = x, cy = y;
-                printf("\033[%d;%df", cy+1, cx+1);
             }
 
             // print the character
-            printf("%c", c->ch);
+            escbuf_char(c->ch);
             cx++;
         }
     }
 
-    fflush(stdout);
+    escbuf_flush();
     fullRefresh = 0;
 }
 
@@ -593,7 +817,7 @@ static void term_mvaddch(int x, int y, int ch, fcolor *fg, fcolor *bg) {
     if (x < 0 || y < 0 || x >= minsize.width || y >= minsize.height) return;
 
     if (colormode == coerce_16) {
-        int c = best(fg, bg);
+        int c = best_cached(fg, bg);
         attrset(COLOR_ATTR(c));
         mvaddch(y, x, ch);
     } else {
@@ -741,9 +965,20 @@ static void term_resize(int w, int h) {
         // I guess we could just zero it all, hmm
         cell_buffer[i].ch = 0;
         cell_buffer[i].pair = 0;
+        cell_buffer[i].drawn = 0;
         cell_buffer[i].fore.idx = 0;
         cell_buffer[i].back.idx = 0;
     }
+
+    // room for a typical full truecolor frame, so that refreshes don't need to grow it
+    if (colormode == truecolor) {
+        escbuf_reserve((size_t) w * h * 16);
+    }
+
+    // the screen was erased, so no pair is in use anymore
+    if (colormode == coerce_256) {
+        initialize_prs();
+    }
 }
 
 static void term_wait(int ms) {
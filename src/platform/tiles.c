@@ -35,9 +35,11 @@ typedef struct ScreenTile {
     short foreRed, foreGreen, foreBlue; // foreground color (0..100)
     short backRed, backGreen, backBlue; // background color (0..100)
     short charIndex;    // index of the glyph to draw
-    short needsRefresh; // true if the tile has changed since the last screen refresh, else false
 } ScreenTile;
 
+#define DIRTY_ROW_WORDS  ((COLS + 63) / 64)  // number of 64-bit words in a row of the dirty bitmap
+#define DIRTY_SUMMARY_WORDS ((ROWS + 63) / 64) // number of 64-bit words in the per-row summary
+
 static SDL_Window *Win = NULL;      // the SDL window
 static SDL_Surface *TilesPNG;       // source PNG
 static SDL_Texture *Textures[4];    // textures used by the renderer to draw tiles
@@ -54,6 +56,8 @@ static boolean tileEmpty[TILE_ROWS][TILE_COLS];   // true if a tile is completel
 static int8_t tileShifts[TILE_ROWS][TILE_COLS][2][MAX_TILE_SIZE][3];
 
 static ScreenTile screenTiles[ROWS][COLS];  // buffer for the expected contents of the screen
+static uint64_t dirtyTiles[ROWS][DIRTY_ROW_WORDS];  // one bit per tile, set if it changed since the last screen refresh
+static uint64_t dirtyRows[DIRTY_SUMMARY_WORDS];     // one bit per row, set if any bit of `dirtyTiles[row]` is set
 static int baseTileWidth = -1;      // width (px) of tiles in the smallest texture (`Textures[0]`)
 static int baseTileHeight = -1;     // height (px) of tiles in the smallest texture (`Textures[0]`)
 
@@ -78,6 +82,21 @@ static void imgfatal(char *file, int line) {
 }
 
 
+/// Returns the index of the lowest set bit of a non-zero word.
+static inline int lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+
 #if !SDL_VERSION_ATLEAST(2, 0, 5)
 
 SDL_Surface *SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth, Uint32 format) {
@@ -542,6 +561,15 @@ static void createTextures(SDL_Renderer *renderer, int outputWidth, int outputHe
         SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
     }
 
+    // The tiles are white with their opacity in the top byte, which reads the same in ARGB8888
+    // and ABGR8888, so build them in whichever of the two the renderer stores as is
+    Uint32 format = SDL_PIXELFORMAT_ARGB8888;
+#ifdef SDL_HINT_RENDER_SHARE_SURFACE_PIXELS // (an SDL with upload format negotiation)
+    if (SDL_GetRendererUploadFormat(renderer, SDL_TRUE) == SDL_PIXELFORMAT_ABGR8888) {
+        format = SDL_PIXELFORMAT_ABGR8888;
+    }
+#endif
+
     // The original image will be resized to 4 possible sizes:
     //  -  Textures[0]: tiles are   W   x   H   pixels
     //  -  Textures[1]: tiles are (W+1) x   H   pixels
@@ -558,7 +586,7 @@ static void createTextures(SDL_Renderer *renderer, int outputWidth, int outputHe
         while (surfaceHeight < tileHeight * TILE_ROWS) surfaceHeight *= 2;
 
         // downscale the tiles
-        SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, surfaceWidth, surfaceHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, surfaceWidth, surfaceHeight, 32, format);
         if (!surface) sdlfatal(__FILE__, __LINE__);
         for (int row = 0; row < TILE_ROWS; row++) {
             for (int column = 0; column < TILE_COLS; column++) {
@@ -598,9 +626,77 @@ void updateTile(int row, int column, short charIndex,
         .backRed   = backRed,
         .backGreen = backGreen,
         .backBlue  = backBlue,
-        .charIndex = charIndex,
-        .needsRefresh = 1
+        .charIndex = charIndex
     };
+    dirtyTiles[row][column / 64] |= (uint64_t)1 << (column % 64);
+    dirtyRows[row / 64] |= (uint64_t)1 << (row % 64);
+}
+
+
+/// Draws a single tile for one of the steps of `updateScreen`.
+///
+/// \param step -1 for the background color, else the index of the texture being drawn
+/// \param x column on screen (between 0 and COLS-1)
+/// \param y row on screen (between 0 and ROWS-1)
+///
+static void drawTile(SDL_Renderer *renderer, int step, int x, int y, int outputWidth, int outputHeight) {
+    int tileWidth = ((x+1) * outputWidth / COLS) - (x * outputWidth / COLS);
+    int tileHeight = ((y+1) * outputHeight / ROWS) - (y * outputHeight / ROWS);
+    if (tileWidth == 0 || tileHeight == 0) return;
+
+    ScreenTile *tile = &screenTiles[y][x];
+
+    if (step < 0) {
+        if (!softwareRendering && tile->backRed == 0 && tile->backGreen == 0 && tile->backBlue == 0) {
+            return; // SDL_RenderClear already painted everything black
+        }
+
+        SDL_Rect dest;
+        dest.w = tileWidth;
+        dest.h = tileHeight;
+        dest.x = x * outputWidth / COLS;
+        dest.y = y * outputHeight / ROWS;
+
+        // paint the background
+        if (SDL_SetRenderDrawColor(renderer,
+            round(2.55 * tile->backRed),
+            round(2.55 * tile->backGreen),
+            round(2.55 * tile->backBlue), 255) < 0) sdlfatal(__FILE__, __LINE__);
+        if (SDL_RenderFillRect(renderer, &dest) < 0) sdlfatal(__FILE__, __LINE__);
+
+    } else {
+        int textureIndex = (numTextures < 4 ? 0 : (tileWidth > baseTileWidth ? 1 : 0) + (tileHeight > baseTileHeight ? 2 : 0));
+        if (step != textureIndex) {
+            return; // this tile uses another texture and gets painted at another step
+        }
+
+        int tileRow    = tile->charIndex / 16;
+        int tileColumn = tile->charIndex % 16;
+
+        if (tileEmpty[tileRow][tileColumn]
+                && !(tileRow == 21 && tileColumn == 1)) {  // wall top (procedural)
+            return; // there is nothing to draw
+        }
+
+        SDL_Rect src;
+        src.w = baseTileWidth  + (step == 1 || step == 3 ? 1 : 0);
+        src.h = baseTileHeight + (step == 2 || step == 3 ? 1 : 0);
+        src.x = src.w * tileColumn;
+        src.y = src.h * tileRow;
+
+        SDL_Rect dest;
+        dest.w = tileWidth;
+        dest.h = tileHeight;
+        dest.x = x * outputWidth / COLS;
+        dest.y = y * outputHeight / ROWS;
+
+        // blend the foreground
+        if (SDL_SetTextureColorMod(Textures[step],
+            round(2.55 * tile->foreRed),
+            round(2.55 * tile->foreGreen),
+            round(2.55 * tile->foreBlue)) < 0) sdlfatal(__FILE__, __LINE__);
+        if (SDL_RenderCopy(renderer, Textures[step], &src, &dest) < 0) sdlfatal(__FILE__, __LINE__);
+    }
 }
 
 
@@ -614,9 +710,10 @@ void updateTile(int row, int column, short charIndex,
 /// The software renderer does not support HiDPI, though.
 ///
 /// To improve performance of the software renderer, we don't redraw the whole screen but
-/// only the tiles that have changed recently (which is tracked with ScreenTile::needsRefresh).
+/// only the tiles that have changed recently (which are tracked in the `dirtyTiles` bitmap).
 /// This works because, unlike the accelerated renderers, the software renderer draws on a
-/// single surface and doesn't do double-buffering.
+/// single surface and doesn't do double-buffering. Rows without any change are skipped
+/// through `dirtyRows`, and the changed tiles of a row are found one 64-bit word at a time.
 ///
 void updateScreen() {
     if (!Win) return;
@@ -655,69 +752,25 @@ void updateScreen() {
 
     for (int step = -1; step < numTextures; step++) {
 
-        for (int x = 0; x < COLS; x++) {
-            int tileWidth = ((x+1) * outputWidth / COLS) - (x * outputWidth / COLS);
-            if (tileWidth == 0) continue;
-
+        if (!softwareRendering) {
             for (int y = 0; y < ROWS; y++) {
-                int tileHeight = ((y+1) * outputHeight / ROWS) - (y * outputHeight / ROWS);
-                if (tileHeight == 0) continue;
-
-                ScreenTile *tile = &screenTiles[y][x];
-                if (softwareRendering && !tile->needsRefresh) {
-                    continue; // software rendering does not use double-buffering, so the tile is still on screen
+                for (int x = 0; x < COLS; x++) {
+                    drawTile(renderer, step, x, y, outputWidth, outputHeight);
                 }
+            }
+            continue;
+        }
 
-                if (step < 0) {
-                    if (!softwareRendering && tile->backRed == 0 && tile->backGreen == 0 && tile->backBlue == 0) {
-                        continue; // SDL_RenderClear already painted everything black
-                    }
-
-                    SDL_Rect dest;
-                    dest.w = tileWidth;
-                    dest.h = tileHeight;
-                    dest.x = x * outputWidth / COLS;
-                    dest.y = y * outputHeight / ROWS;
-
-                    // paint the background
-                    if (SDL_SetRenderDrawColor(renderer,
-                        round(2.55 * tile->backRed),
-                        round(2.55 * tile->backGreen),
-                        round(2.55 * tile->backBlue), 255) < 0) sdlfatal(__FILE__, __LINE__);
-                    if (SDL_RenderFillRect(renderer, &dest) < 0) sdlfatal(__FILE__, __LINE__);
-
-                } else {
-                    int textureIndex = (numTextures < 4 ? 0 : (tileWidth > baseTileWidth ? 1 : 0) + (tileHeight > baseTileHeight ? 2 : 0));
-                    if (step != textureIndex) {
-                        continue; // this tile uses another texture and gets painted at another step
-                    }
-
-                    int tileRow    = tile->charIndex / 16;
-                    int tileColumn = tile->charIndex % 16;
+        // software rendering does not use double-buffering, so only the changed tiles need to be drawn
+        for (int rowWord = 0; rowWord < DIRTY_SUMMARY_WORDS; rowWord++) {
+            for (uint64_t rows = dirtyRows[rowWord]; rows; rows &= rows - 1) {
+                int y = rowWord * 64 + lowestBit(rows);
 
-                    if (tileEmpty[tileRow][tileColumn]
-                            && !(tileRow == 21 && tileColumn == 1)) {  // wall top (procedural)
-                        continue; // there is nothing to draw
+                for (int word = 0; word < DIRTY_ROW_WORDS; word++) {
+                    for (uint64_t bits = dirtyTiles[y][word]; bits; bits &= bits - 1) {
+                        int x = word * 64 + lowestBit(bits);
+                        drawTile(renderer, step, x, y, outputWidth, outputHeight);
                     }
-
-                    SDL_Rect src;
-                    src.w = baseTileWidth  + (step == 1 || step == 3 ? 1 : 0);
-                    src.h = baseTileHeight + (step == 2 || step == 3 ? 1 : 0);
-                    src.x = src.w * tileColumn;
-                    src.y = src.h * tileRow;
-
-                    SDL_Rect dest;
-                    dest.w = tileWidth;
-                    dest.h = tileHeight;
-                    dest.x = x * outputWidth / COLS;
-                    dest.y = y * outputHeight / ROWS;
-
-                    // blend the foreground
-                    if (SDL_SetTextureColorMod(Textures[step],
-                        round(2.55 * tile->foreRed),
-                        round(2.55 * tile->foreGreen),
-                        round(2.55 * tile->foreBlue)) < 0) sdlfatal(__FILE__, __LINE__);
-                    if (SDL_RenderCopy(renderer, Textures[step], &src, &dest) < 0) sdlfatal(__FILE__, __LINE__);
                 }
             }
         }
@@ -726,11 +779,8 @@ void updateScreen() {
     SDL_RenderPresent(renderer);
 
     // the screen is now up to date
-    for (int y = 0; y < ROWS; y++) {
-        for (int x = 0; x < COLS; x++) {
-            screenTiles[y][x].needsRefresh = 0;
-        }
-    }
+    memset(dirtyTiles, 0, sizeof(dirtyTiles));
+    memset(dirtyRows, 0, sizeof(dirtyRows));
 }
 
 